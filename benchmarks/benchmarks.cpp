@@ -0,0 +1,832 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "contraction.hpp"
+#include "delta_stepping.hpp"
+#include "dijkstra.hpp"
+#include "generators.hpp"
+#include "heuristics.hpp"
+#include "snapshot.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Benchmarks of the construction, searches and memory footprint of Graph, of its frozen copies, snapshots and contraction hierarchies, and of the scaling of delta-stepping and distance matrices with the threads,
+ *	over the synthetic graphs of generators.hpp.
+ *	Run the target benchmark_json to keep the results in benchmarks.json, or pass --benchmark_format=json to dijkstra_benchmarks.
+ */
+
+using namespace dijkstra;
+using namespace dijkstra::generators;
+
+using weight_type = uint_fast32_t;
+
+/* MEMORY */
+
+// the bytes allocated and not freed yet, through a header in front of every allocation with the address of the block and the size
+static std::atomic<size_t> live_bytes(0);
+
+/*
+ * Allocates an aligned block, with the address returned by malloc and the size stored right in front of it.
+ */
+static void* allocate(size_t size, size_t alignment) {
+	alignment = std::max(alignment, alignof(std::max_align_t));
+	auto* block = static_cast<char*>(std::malloc(size + alignment + 2 * sizeof(size_t)));
+
+	if (block == nullptr)
+		throw std::bad_alloc();
+
+	const auto address = reinterpret_cast<uintptr_t>(block) + 2 * sizeof(size_t);
+	auto* pointer = reinterpret_cast<size_t*>((address + alignment - 1) / alignment * alignment);
+	pointer[-2] = reinterpret_cast<uintptr_t>(block);
+	pointer[-1] = size;
+	live_bytes += size;
+
+	return pointer;
+}
+
+/*
+ * Frees a block allocated by allocate().
+ */
+static void deallocate(void* pointer) noexcept {
+	if (pointer == nullptr)
+		return;
+
+	live_bytes -= static_cast<size_t*>(pointer)[-1];
+	std::free(reinterpret_cast<void*>(static_cast<size_t*>(pointer)[-2]));
+}
+
+void* operator new(size_t size) {
+	return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+	return allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+	deallocate(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+	deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+	deallocate(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+	deallocate(pointer);
+}
+
+/*
+ * Returns the resident set size of the process in bytes, or 0 where it cannot be read.
+ *
+ * @param	trim	true to give the free memory of the heap back to the system first, so that the next allocations grow the resident set
+ */
+static size_t resident(bool trim = false) {
+#ifdef __GLIBC__
+	if (trim)
+		malloc_trim(0);
+#endif
+#ifdef __linux__
+	long pages = 0, resident_pages = 0;
+
+	if (auto* file = std::fopen("/proc/self/statm", "r")) {
+		if (std::fscanf(file, "%ld %ld", &pages, &resident_pages) != 2)
+			resident_pages = 0;
+		std::fclose(file);
+	}
+
+	return static_cast<size_t>(resident_pages) * 4096;
+#else
+	return 0;
+#endif
+}
+
+/* GRAPHS */
+
+/*
+ * The families of generated graphs.
+ */
+enum Family : int64_t {
+	RANDOM,
+	GRID,
+	SCALE_FREE,
+	ROAD,
+	DENSE,
+};
+
+static const char* const family_names[] = { "random", "grid", "scale_free", "road", "dense" };
+
+/*
+ * Generates a graph of a family with about n nodes, once per family and size.
+ */
+static const EdgeList<weight_type>& edge_list(Family family, size_t n) {
+	static auto cache = std::map<std::pair<Family, size_t>, EdgeList<weight_type>>();
+	auto it = cache.find({ family, n });
+
+	if (it == cache.end()) {
+		auto side = static_cast<size_t>(std::sqrt(double(n)));
+
+		switch (family) {
+			case RANDOM: it = cache.emplace(std::make_pair(family, n), random_graph<weight_type>(n, 4 * n)).first; break;
+			case GRID: it = cache.emplace(std::make_pair(family, n), grid_graph<weight_type>(side, side)).first; break;
+			case SCALE_FREE: it = cache.emplace(std::make_pair(family, n), scale_free_graph<weight_type>(n)).first; break;
+			case ROAD: it = cache.emplace(std::make_pair(family, n), road_graph<weight_type>(n)).first; break;
+			// a degree that grows as the square root of n, so that the queue holds a large share of the nodes
+			case DENSE: it = cache.emplace(std::make_pair(family, n), random_graph<weight_type>(n, n * side / 4)).first; break;
+		}
+	}
+
+	return it->second;
+}
+
+/*
+ * Builds the Graph of a family with about n nodes, once per family and size.
+ */
+static const Graph<weight_type>& graph(Family family, size_t n) {
+	static auto cache = std::map<std::pair<Family, size_t>, Graph<weight_type>>();
+	auto it = cache.find({ family, n });
+
+	if (it == cache.end())
+		it = cache.emplace(std::make_pair(family, n), to_graph(edge_list(family, n))).first;
+
+	return it->second;
+}
+
+/*
+ * Freezes the Graph of a family with about n nodes, once per family and size.
+ */
+static const FrozenGraph<weight_type>& frozen(Family family, size_t n) {
+	static auto cache = std::map<std::pair<Family, size_t>, FrozenGraph<weight_type>>();
+	auto it = cache.find({ family, n });
+
+	if (it == cache.end())
+		it = cache.emplace(std::make_pair(family, n), graph(family, n).freeze()).first;
+
+	return it->second;
+}
+
+/*
+ * Preprocesses the contraction hierarchy of the Graph of a family with about n nodes, once per family and size, and keeps the time it took in milliseconds.
+ */
+static const std::pair<ContractionHierarchy<weight_type>, double>& hierarchy(Family family, size_t n) {
+	static auto cache = std::map<std::pair<Family, size_t>, std::pair<ContractionHierarchy<weight_type>, double>>();
+	auto it = cache.find({ family, n });
+
+	if (it == cache.end()) {
+		const auto& g = graph(family, n);
+		const auto start = std::chrono::steady_clock::now();
+		auto ch = ContractionHierarchy<weight_type>(g);
+		const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		it = cache.emplace(std::make_pair(family, n), std::make_pair(std::move(ch), elapsed)).first;
+	}
+
+	return it->second;
+}
+
+/*
+ * Draws pairs of distinct nodes in the component of the first node that reaches half of the graph, so that a path always exists,
+ * as the first nodes of the sparsest graphs may be isolated.
+ */
+static std::vector<std::pair<vertex_id, vertex_id>> pairs(const Graph<weight_type>& graph, size_t count) {
+	auto reachable = std::vector<vertex_id>();
+	auto result = std::vector<std::pair<vertex_id, vertex_id>>();
+	auto rng = std::mt19937_64(42);
+
+	for (vertex_id root = 0; 2 * reachable.size() < graph.get_nodes().size(); ++root) {
+		const auto tree = graph.shortest_path_tree<QuaternaryHeap>(root);
+
+		reachable.clear();
+		for (vertex_id v = 0; v < tree.distances.size(); ++v)
+			if (tree.distances[v] != std::numeric_limits<weight_type>::max())
+				reachable.push_back(v);
+	}
+
+	auto draw = std::uniform_int_distribution<size_t>(0, reachable.size() - 1);
+	while (result.size() < count) {
+		const auto src = reachable[draw(rng)], dst = reachable[draw(rng)];
+
+		if (src != dst)
+			result.emplace_back(src, dst);
+	}
+
+	return result;
+}
+
+static const int64_t sizes[] = { 1 << 10, 1 << 13, 1 << 16 };
+
+/*
+ * Registers every size.
+ */
+static void sizes_only(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "n" });
+
+	for (const auto n : sizes)
+		benchmark->Args({ n });
+}
+
+/*
+ * Registers every family at every size.
+ */
+static void families(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n" });
+
+	for (const auto family : { RANDOM, GRID, SCALE_FREE, ROAD })
+		for (const auto n : sizes)
+			benchmark->Args({ family, n });
+}
+
+/*
+ * Registers every family at every size, and the dense graphs, on which the queue holds the most nodes.
+ */
+static void with_dense(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n" });
+
+	for (const auto family : { RANDOM, GRID, SCALE_FREE, ROAD, DENSE })
+		for (const auto n : sizes)
+			benchmark->Args({ family, n });
+}
+
+/*
+ * Registers the road graphs from 10^4 to 10^7 nodes, the largest of which takes a few gigabytes as a Graph.
+ */
+static void decades(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n" });
+
+	for (int64_t n = 10000; n <= 10000000; n *= 10)
+		benchmark->Args({ ROAD, n });
+}
+
+/* CONSTRUCTION */
+
+static void add_node(benchmark::State& state) {
+	const auto n = static_cast<size_t>(state.range(0));
+	auto labels = std::vector<std::string>();
+
+	for (size_t v = 0; v < n; ++v)
+		labels.push_back(std::to_string(v));
+
+	for (auto _ : state) {
+		auto g = Graph<weight_type>();
+
+		for (const auto& label : labels)
+			g.add_node(label);
+
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(add_node)->Apply(sizes_only)->Unit(benchmark::kMillisecond);
+
+static void add_edge(benchmark::State& state) {
+	const auto& list = edge_list(static_cast<Family>(state.range(0)), state.range(1));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto g = Graph<weight_type>();
+		for (size_t v = 0; v < list.n; ++v)
+			g.add_node(std::to_string(v));
+		state.ResumeTiming();
+
+		for (const auto& [u, v, weight] : list.edges)
+			g.add_edge(u, v, weight);
+
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * list.edges.size());
+	state.SetLabel(family_names[state.range(0)]);
+}
+BENCHMARK(add_edge)->Apply(families)->Unit(benchmark::kMillisecond);
+
+/*
+ * Builds a whole graph from the labels of its edges, viewed in one text as a loader would read them.
+ * The labels are either copied into a string for each add_edge, as the former signatures taking strings required, or passed as they are to the builder calls: reserve, then emplace_edge, chained.
+ */
+template <bool builder>
+static void build_labels(benchmark::State& state) {
+	const auto& list = edge_list(static_cast<Family>(state.range(0)), state.range(1));
+	auto text = std::string();
+	auto labels = std::vector<std::string_view>();
+
+	for (size_t v = 0; v < list.n; ++v)
+		text += "intersection #" + std::to_string(v) + "\n";
+	for (size_t begin = 0, end; (end = text.find('\n', begin)) != std::string::npos; begin = end + 1)
+		labels.emplace_back(text.data() + begin, end - begin);
+
+	for (auto _ : state) {
+		auto g = Graph<weight_type>();
+
+		if constexpr (builder) {
+			g.reserve(list.n);
+			for (const auto& [u, v, weight] : list.edges)
+				g.emplace_edge(labels[u], labels[v], weight);
+		}
+		else
+			for (const auto& [u, v, weight] : list.edges)
+				g.add_edge(std::string(labels[u]), std::string(labels[v]), weight);
+
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * list.edges.size());
+	state.SetLabel(family_names[state.range(0)]);
+}
+BENCHMARK_TEMPLATE(build_labels, false)->Apply(families)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(build_labels, true)->Apply(families)->Unit(benchmark::kMillisecond);
+
+/* SEARCHES */
+
+template <template <typename> class Queue, Insertion mode>
+static void find(benchmark::State& state) {
+	const auto& g = graph(static_cast<Family>(state.range(0)), state.range(1));
+	const auto queries = pairs(g, 64);
+	size_t i = 0, settled = 0;
+
+	for (auto _ : state) {
+		const auto& [src, dst] = queries[i++ % queries.size()];
+		benchmark::DoNotOptimize(g.template find<Queue>(src, dst, mode));
+	}
+
+	// the statistics are gathered outside the timed loop, so that they do not weigh on it
+	for (const auto& [src, dst] : queries)
+		g.template find<Queue>(src, dst, mode, [&settled](const QueryStatistics& statistics) { settled += statistics.settled; });
+
+	state.counters["settled"] = benchmark::Counter(double(settled) / queries.size());
+	state.SetLabel(family_names[state.range(0)]);
+}
+BENCHMARK_TEMPLATE(find, FibonacciHeap, Insertion::EAGER)->Apply(with_dense)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find, FibonacciHeap, Insertion::LAZY)->Apply(with_dense)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find, PairingHeap, Insertion::LAZY)->Apply(with_dense)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find, QuaternaryHeap, Insertion::LAZY)->Apply(with_dense)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find, LazyBinaryHeap, Insertion::LAZY)->Apply(with_dense)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find, RadixHeap, Insertion::LAZY)->Apply(with_dense)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find, QuaternaryHeap, Insertion::LAZY)->Apply(decades)->Unit(benchmark::kMicrosecond);
+
+/*
+ * Finds the paths between the labels of the same queries in a Graph and in its FrozenGraph, with the same queue, to compare the layouts of their edges.
+ */
+template <bool freeze>
+static void find_labels(benchmark::State& state) {
+	const auto& g = graph(static_cast<Family>(state.range(0)), state.range(1));
+	auto queries = std::vector<std::pair<std::string_view, std::string_view>>();
+	size_t i = 0;
+
+	for (const auto& [src, dst] : pairs(g, 64))
+		queries.emplace_back(g.label(src), g.label(dst));
+
+	if constexpr (freeze) {
+		const auto& f = frozen(static_cast<Family>(state.range(0)), state.range(1));
+
+		for (auto _ : state) {
+			const auto& [src, dst] = queries[i++ % queries.size()];
+			benchmark::DoNotOptimize(f.find<QuaternaryHeap>(src, dst, Insertion::LAZY));
+		}
+	}
+	else
+		for (auto _ : state) {
+			const auto& [src, dst] = queries[i++ % queries.size()];
+			benchmark::DoNotOptimize(g.find<QuaternaryHeap>(src, dst, Insertion::LAZY));
+		}
+
+	state.SetLabel(std::string(family_names[state.range(0)]) + (freeze ? "/frozen" : "/graph"));
+}
+BENCHMARK_TEMPLATE(find_labels, false)->Apply(families)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find_labels, true)->Apply(families)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find_labels, false)->Apply(decades)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find_labels, true)->Apply(decades)->Unit(benchmark::kMicrosecond);
+
+template <template <typename> class Queue>
+static void find_context(benchmark::State& state) {
+	const auto& g = graph(static_cast<Family>(state.range(0)), state.range(1));
+	const auto queries = pairs(g, 64);
+	auto context = SearchContext<weight_type, Queue>();
+	size_t i = 0;
+
+	for (auto _ : state) {
+		const auto& [src, dst] = queries[i++ % queries.size()];
+		benchmark::DoNotOptimize(g.find(src, dst, context));
+	}
+
+	state.SetLabel(family_names[state.range(0)]);
+}
+BENCHMARK_TEMPLATE(find_context, QuaternaryHeap)->Apply(families)->Unit(benchmark::kMicrosecond);
+
+static void find_batch(benchmark::State& state) {
+	const auto& g = graph(static_cast<Family>(state.range(0)), state.range(1));
+	auto queries = pairs(g, 64);
+
+	// 8 sources with 8 destinations each, as the batches that group many queries by source
+	for (size_t i = 0; i < queries.size(); ++i)
+		queries[i].first = queries[i - i % 8].first;
+	queries.erase(std::remove_if(queries.begin(), queries.end(), [](const auto& query) { return query.first == query.second; }), queries.end());
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(g.find_batch<QuaternaryHeap>(queries, 1));
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+	state.SetLabel(family_names[state.range(0)]);
+}
+BENCHMARK(find_batch)->Apply(families)->Unit(benchmark::kMicrosecond);
+
+/*
+ * The estimates of the distance to the destination that guide A*.
+ */
+enum Estimate : int64_t {
+	NONE,
+	EUCLIDEAN,
+	LANDMARKS,
+};
+
+static const char* const estimate_names[] = { "none", "euclidean", "landmarks" };
+
+/*
+ * Registers every family at every size with every estimate, but the Euclidean one on the families without coordinates.
+ */
+static void estimates(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n", "estimate" });
+
+	for (const auto family : { RANDOM, GRID, SCALE_FREE, ROAD })
+		for (const auto n : sizes)
+			for (const auto estimate : { NONE, EUCLIDEAN, LANDMARKS })
+				if (estimate != EUCLIDEAN || family == GRID || family == ROAD)
+					benchmark->Args({ family, n, estimate });
+}
+
+/*
+ * Runs the queries with A* and a heuristic, and reports the nodes settled per query.
+ */
+template <class Heuristic>
+static void astar(benchmark::State& state, const Graph<weight_type>& g, const Heuristic& heuristic) {
+	const auto queries = pairs(g, 64);
+	size_t i = 0, settled = 0;
+
+	for (auto _ : state) {
+		const auto& [src, dst] = queries[i++ % queries.size()];
+		benchmark::DoNotOptimize(g.find_astar<QuaternaryHeap>(src, dst, heuristic));
+	}
+
+	for (const auto& [src, dst] : queries)
+		g.find_astar<QuaternaryHeap>(src, dst, heuristic, [&settled](const QueryStatistics& statistics) { settled += statistics.settled; });
+
+	state.counters["settled"] = benchmark::Counter(double(settled) / queries.size());
+}
+
+/*
+ * Compares the nodes settled by A* with each estimate, against a null one with which A* settles the nodes as Dijkstra's algorithm.
+ * The weights of the grids are at least the length of their edges, and those of the road graphs a hundred times, so that the Euclidean estimate stays a lower bound.
+ */
+static void find_astar(benchmark::State& state) {
+	const auto family = static_cast<Family>(state.range(0));
+	const auto& g = graph(family, state.range(1));
+
+	switch (static_cast<Estimate>(state.range(2))) {
+		case NONE: astar(state, g, [](vertex_id, vertex_id) { return weight_type(0); }); break;
+		case EUCLIDEAN: astar(state, g, EuclideanHeuristic<weight_type>(g, family == ROAD ? 100 : 1)); break;
+		case LANDMARKS: astar(state, g, LandmarkHeuristic<weight_type>(g, 8)); break;
+	}
+
+	state.SetLabel(std::string(family_names[family]) + "/" + estimate_names[state.range(2)]);
+}
+BENCHMARK(find_astar)->Apply(estimates)->Unit(benchmark::kMicrosecond);
+
+/*
+ * Registers the grids and road graphs at every size, whose contraction hierarchies take few shortcuts.
+ */
+static void planar(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n" });
+
+	for (const auto family : { GRID, ROAD })
+		for (const auto n : sizes)
+			benchmark->Args({ family, n });
+}
+
+/*
+ * Answers the queries with a contraction hierarchy, by distance only or with the path unpacked, and reports the time of its preprocessing.
+ */
+template <bool unpack>
+static void find_hierarchy(benchmark::State& state) {
+	const auto& g = graph(static_cast<Family>(state.range(0)), state.range(1));
+	const auto& [ch, preprocessing] = hierarchy(static_cast<Family>(state.range(0)), state.range(1));
+	auto queries = std::vector<std::pair<std::string_view, std::string_view>>();
+	auto query = ContractionHierarchy<weight_type>::Query();
+	size_t i = 0;
+
+	for (const auto& [src, dst] : pairs(g, 64))
+		queries.emplace_back(g.label(src), g.label(dst));
+
+	for (auto _ : state) {
+		const auto& [src, dst] = queries[i++ % queries.size()];
+
+		if constexpr (unpack)
+			benchmark::DoNotOptimize(ch.find(src, dst, query));
+		else
+			benchmark::DoNotOptimize(ch.distance(src, dst, query));
+	}
+
+	state.counters["preprocessing_ms"] = benchmark::Counter(preprocessing);
+	state.SetLabel(std::string(family_names[state.range(0)]) + (unpack ? "/path" : "/distance"));
+}
+BENCHMARK_TEMPLATE(find_hierarchy, false)->Apply(planar)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(find_hierarchy, true)->Apply(planar)->Unit(benchmark::kMicrosecond);
+
+/* ONE-TO-ALL SEARCHES */
+
+/*
+ * Registers every family at the largest size, with 0 threads for the sequential search and then powers of two up to the number of cores.
+ */
+static void scaling(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n", "threads" });
+
+	for (const auto family : { RANDOM, GRID, SCALE_FREE, ROAD }) {
+		benchmark->Args({ family, sizes[2], 0 });
+		for (int64_t threads = 1; threads <= std::max<int64_t>(std::thread::hardware_concurrency(), 1); threads *= 2)
+			benchmark->Args({ family, sizes[2], threads });
+	}
+}
+
+static void one_to_all(benchmark::State& state) {
+	const auto& g = graph(static_cast<Family>(state.range(0)), state.range(1));
+	const auto threads = static_cast<size_t>(state.range(2));
+
+	if (threads == 0)
+		for (auto _ : state)
+			benchmark::DoNotOptimize(g.shortest_path_tree<QuaternaryHeap>(0));
+	else {
+		auto pool = ThreadPool(threads);
+		const auto engine = DeltaStepping<weight_type>(g, pool);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(engine.distances(0, pool));
+		state.counters["delta"] = benchmark::Counter(double(engine.delta()));
+	}
+
+	state.SetItemsProcessed(state.iterations() * g.get_nodes().size());
+	state.SetLabel(std::string(family_names[state.range(0)]) + (threads == 0 ? "/dijkstra" : "/delta_stepping"));
+}
+BENCHMARK(one_to_all)->Apply(scaling)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/*
+ * Registers every family at the largest size, with powers of two threads up to the number of cores.
+ */
+static void thread_counts(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n", "threads" });
+
+	for (const auto family : { RANDOM, GRID, SCALE_FREE, ROAD })
+		for (int64_t threads = 1; threads <= std::max<int64_t>(std::thread::hardware_concurrency(), 1); threads *= 2)
+			benchmark->Args({ family, sizes[2], threads });
+}
+
+/*
+ * Computes the distances between 32 sources and 32 targets of a frozen graph, and reports the queries, one per pair, per second.
+ */
+static void distance_matrix(benchmark::State& state) {
+	const auto& g = graph(static_cast<Family>(state.range(0)), state.range(1));
+	const auto& f = frozen(static_cast<Family>(state.range(0)), state.range(1));
+	auto sources = std::vector<std::string_view>(), targets = std::vector<std::string_view>();
+	auto pool = ThreadPool(static_cast<size_t>(state.range(2)));
+
+	for (const auto& [src, dst] : pairs(g, 32)) {
+		sources.push_back(g.label(src));
+		targets.push_back(g.label(dst));
+	}
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(f.distance_matrix<QuaternaryHeap>(sources, targets, pool));
+
+	state.SetItemsProcessed(state.iterations() * sources.size() * targets.size());
+	state.SetLabel(family_names[state.range(0)]);
+}
+BENCHMARK(distance_matrix)->Apply(thread_counts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/* SNAPSHOTS */
+
+/*
+ * Writes the snapshot of a frozen graph into the temporary directory.
+ */
+static void snapshot_save(benchmark::State& state) {
+	const auto& f = frozen(static_cast<Family>(state.range(0)), state.range(1));
+	const auto path = std::filesystem::temp_directory_path() / "dijkstra_benchmarks.snapshot";
+
+	for (auto _ : state)
+		save_snapshot(f, path);
+
+	state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+	state.SetLabel(family_names[state.range(0)]);
+	std::filesystem::remove(path);
+}
+BENCHMARK(snapshot_save)->Apply(families)->Unit(benchmark::kMillisecond);
+
+/*
+ * Maps the snapshot of a frozen graph, either trusting its arrays, which only reads the header and the ends of the offsets, or validating them in a pass over the whole file.
+ */
+template <bool validate>
+static void snapshot_open(benchmark::State& state) {
+	const auto path = std::filesystem::temp_directory_path() / "dijkstra_benchmarks.snapshot";
+
+	save_snapshot(frozen(static_cast<Family>(state.range(0)), state.range(1)), path);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(open_snapshot<weight_type>(path, validate));
+
+	state.counters["bytes"] = benchmark::Counter(double(std::filesystem::file_size(path)));
+	state.SetLabel(std::string(family_names[state.range(0)]) + (validate ? "/validated" : "/trusted"));
+	std::filesystem::remove(path);
+}
+BENCHMARK_TEMPLATE(snapshot_open, false)->Apply(families)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(snapshot_open, true)->Apply(families)->Unit(benchmark::kMicrosecond);
+
+/* DESTRUCTION */
+
+static void remove_node(benchmark::State& state) {
+	const auto& original = graph(static_cast<Family>(state.range(0)), state.range(1));
+	auto rng = std::mt19937_64(42);
+	auto draw = std::uniform_int_distribution<vertex_id>(0, static_cast<vertex_id>(original.get_nodes().size() - 1));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto g = original;
+		const auto v = draw(rng);
+		state.ResumeTiming();
+
+		g.remove_node(v);
+
+		state.PauseTiming();
+		g = Graph<weight_type>();
+		state.ResumeTiming();
+	}
+
+	state.SetLabel(family_names[state.range(0)]);
+}
+BENCHMARK(remove_node)->Apply(families)->Unit(benchmark::kMicrosecond);
+
+/*
+ * The ways to remove a batch of nodes from an oriented graph.
+ */
+enum Removal : int64_t {
+	ONE_BY_ONE,
+	SWEEP,
+	REVERSE_INDEX,
+};
+
+static const char* const removal_names[] = { "one_by_one", "sweep", "reverse_index" };
+
+/*
+ * Registers every family at every size with every way of removing nodes, but the removals one by one on the largest graphs, that scan them for every node.
+ */
+static void removals(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n", "removal" });
+
+	for (const auto family : { RANDOM, GRID, SCALE_FREE, ROAD })
+		for (const auto n : sizes)
+			for (const auto removal : { ONE_BY_ONE, SWEEP, REVERSE_INDEX })
+				if (removal != ONE_BY_ONE || n < sizes[2])
+					benchmark->Args({ family, n, removal });
+}
+
+static void remove_nodes(benchmark::State& state) {
+	const auto removal = static_cast<Removal>(state.range(2));
+	auto original = to_graph(edge_list(static_cast<Family>(state.range(0)), state.range(1)), Orientation::ORIENTED);
+	auto rng = std::mt19937_64(42);
+	auto draw = std::uniform_int_distribution<vertex_id>(0, static_cast<vertex_id>(original.get_nodes().size() - 1));
+	// one node in sixteen
+	auto batch = std::vector<vertex_id>(original.get_nodes().size() / 16);
+
+	if (removal == REVERSE_INDEX)
+		original.set_reverse_index(true);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto g = original;
+		for (auto& v : batch)
+			v = draw(rng);
+		state.ResumeTiming();
+
+		if (removal == ONE_BY_ONE)
+			for (const auto v : batch)
+				g.remove_node(v);
+		else
+			g.remove_nodes(batch);
+
+		state.PauseTiming();
+		g = Graph<weight_type>();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * batch.size());
+	state.SetLabel(std::string(family_names[state.range(0)]) + "/" + removal_names[removal]);
+}
+BENCHMARK(remove_nodes)->Apply(removals)->Unit(benchmark::kMillisecond);
+
+/* MEMORY */
+
+static void memory(benchmark::State& state) {
+	const auto& list = edge_list(static_cast<Family>(state.range(0)), state.range(1));
+	size_t bytes = 0;
+
+	for (auto _ : state) {
+		const auto before = live_bytes.load();
+		auto g = to_graph(list);
+		bytes = live_bytes.load() - before;
+
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.counters["bytes"] = benchmark::Counter(double(bytes));
+	state.counters["bytes_per_node"] = benchmark::Counter(double(bytes) / list.n);
+	state.counters["bytes_per_edge"] = benchmark::Counter(double(bytes) / list.edges.size());
+	state.SetLabel(family_names[state.range(0)]);
+}
+BENCHMARK(memory)->Apply(families)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+/*
+ * The memory resources the edges of a graph can be allocated from.
+ */
+enum Resource : int64_t {
+	NEW_DELETE,
+	MONOTONIC,
+	POOL,
+};
+
+static const char* const resource_names[] = { "new_delete", "monotonic", "pool" };
+
+static std::unique_ptr<std::pmr::memory_resource> make_resource(Resource resource) {
+	switch (resource) {
+		case MONOTONIC: return std::make_unique<std::pmr::monotonic_buffer_resource>(size_t(1) << 20);
+		case POOL: return std::make_unique<std::pmr::unsynchronized_pool_resource>();
+		default: return nullptr;
+	}
+}
+
+/*
+ * Registers every memory resource for the largest graphs.
+ */
+static void resources(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "family", "n", "resource" });
+
+	for (const auto family : { RANDOM, ROAD })
+		for (const auto resource : { NEW_DELETE, MONOTONIC, POOL })
+			benchmark->Args({ family, 1 << 16, resource });
+}
+
+/*
+ * Measures the build of a graph into a memory resource, and reports the growth of the resident set and the time to free the graph and its resource.
+ */
+static void build(benchmark::State& state) {
+	const auto& list = edge_list(static_cast<Family>(state.range(0)), state.range(1));
+	const auto kind = static_cast<Resource>(state.range(2));
+	double destruction = 0, rss = 0, bytes = 0;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto resource = make_resource(kind);
+		const auto before = resident(true);
+		const auto live = live_bytes.load();
+		state.ResumeTiming();
+
+		auto g = std::make_unique<Graph<weight_type>>(to_graph(list, Orientation::UNORIENTED, resource ? resource.get() : std::pmr::new_delete_resource()));
+
+		state.PauseTiming();
+		rss += double(resident() - before);
+		bytes += double(live_bytes.load() - live);
+		const auto start = std::chrono::steady_clock::now();
+		g.reset();
+		resource.reset();
+		destruction += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		state.ResumeTiming();
+	}
+
+	state.counters["rss"] = benchmark::Counter(rss / state.iterations());
+	state.counters["bytes"] = benchmark::Counter(bytes / state.iterations());
+	state.counters["destruction_ms"] = benchmark::Counter(destruction / state.iterations());
+	state.SetLabel(std::string(family_names[state.range(0)]) + "/" + resource_names[state.range(2)]);
+}
+BENCHMARK(build)->Apply(resources)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,207 @@
+#ifndef GENERATORS_HPP
+#define GENERATORS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "dijkstra.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Generators of synthetic graphs for the benchmarks, that are deterministic for a given seed.
+ */
+namespace dijkstra::generators {
+	using namespace std;
+
+	/*
+	* A generated graph.
+	* - n : the number of nodes, identified from 0 to n - 1
+	* - edges : the first node, second node and weight of each edge
+	* - coordinates : the position of each node, or empty if the graph has no geometry
+	*/
+	template <typename W>
+	struct EdgeList {
+		size_t n = 0;
+		vector<tuple<vertex_id, vertex_id, W>> edges;
+		vector<Coordinates> coordinates;
+	};
+
+	/*
+	* Generates a random graph G(n, m), whose edges join two nodes drawn uniformly.
+	*
+	* @param	n	the number of nodes
+	* @param	m	the number of edges
+	* @param	max_weight	the largest weight, the weights being drawn uniformly from 1
+	* @param	seed	the seed
+	* @return	the graph
+	*/
+	template <typename W = uint_fast32_t>
+	EdgeList<W> random_graph(size_t n, size_t m, W max_weight = 100, uint64_t seed = 1) {
+		auto rng = mt19937_64(seed);
+		auto node = uniform_int_distribution<vertex_id>(0, static_cast<vertex_id>(n - 1));
+		auto weight = uniform_int_distribution<W>(1, max_weight);
+		auto result = EdgeList<W>{ n, {}, {} };
+
+		result.edges.reserve(m);
+		while (result.edges.size() < m) {
+			const auto u = node(rng), v = node(rng);
+
+			if (u != v)
+				result.edges.emplace_back(u, v, weight(rng));
+		}
+
+		return result;
+	}
+
+	/*
+	* Generates a 2D grid, where each node is joined to its right and bottom neighbors.
+	*
+	* @param	width	the number of columns
+	* @param	height	the number of rows
+	* @param	max_weight	the largest weight, the weights being drawn uniformly from 1
+	* @param	seed	the seed
+	* @return	the graph, with the coordinates of the cells
+	*/
+	template <typename W = uint_fast32_t>
+	EdgeList<W> grid_graph(size_t width, size_t height, W max_weight = 100, uint64_t seed = 1) {
+		auto rng = mt19937_64(seed);
+		auto weight = uniform_int_distribution<W>(1, max_weight);
+		auto result = EdgeList<W>{ width * height, {}, {} };
+
+		result.edges.reserve(2 * width * height);
+		result.coordinates.reserve(width * height);
+		for (size_t y = 0; y < height; ++y)
+			for (size_t x = 0; x < width; ++x) {
+				const auto v = static_cast<vertex_id>(y * width + x);
+
+				result.coordinates.push_back({ double(x), double(y) });
+				if (x + 1 < width)
+					result.edges.emplace_back(v, v + 1, weight(rng));
+				if (y + 1 < height)
+					result.edges.emplace_back(v, static_cast<vertex_id>(v + width), weight(rng));
+			}
+
+		return result;
+	}
+
+	/*
+	* Generates a scale-free graph with the Barabási-Albert model: each new node is joined to m existing nodes,
+	* chosen with a probability proportional to their degree.
+	*
+	* @param	n	the number of nodes
+	* @param	m	the number of edges of each new node
+	* @param	max_weight	the largest weight, the weights being drawn uniformly from 1
+	* @param	seed	the seed
+	* @return	the graph
+	* @cite	@article{barabasi1999emergence, title={Emergence of scaling in random networks}, author={Barab{\'a}si, Albert-L{\'a}szl{\'o} and Albert, R{\'e}ka}, journal={Science}, volume={286}, number={5439}, pages={509--512}, year={1999}}
+	*/
+	template <typename W = uint_fast32_t>
+	EdgeList<W> scale_free_graph(size_t n, size_t m = 3, W max_weight = 100, uint64_t seed = 1) {
+		auto rng = mt19937_64(seed);
+		auto weight = uniform_int_distribution<W>(1, max_weight);
+		auto result = EdgeList<W>{ n, {}, {} };
+		// every node appears once per edge it is an end of, so that a uniform draw follows the degrees
+		auto ends = vector<vertex_id>();
+		auto targets = vector<vertex_id>();
+
+		// the first m + 1 nodes form a clique
+		for (vertex_id u = 0; u <= m && u < n; ++u)
+			for (vertex_id v = 0; v < u; ++v) {
+				result.edges.emplace_back(u, v, weight(rng));
+				ends.push_back(u);
+				ends.push_back(v);
+			}
+
+		for (auto u = static_cast<vertex_id>(m + 1); u < n; ++u) {
+			targets.clear();
+			while (targets.size() < m) {
+				const auto v = ends[uniform_int_distribution<size_t>(0, ends.size() - 1)(rng)];
+
+				if (find(targets.begin(), targets.end(), v) == targets.end())
+					targets.push_back(v);
+			}
+
+			for (const auto v : targets) {
+				result.edges.emplace_back(u, v, weight(rng));
+				ends.push_back(u);
+				ends.push_back(v);
+			}
+		}
+
+		return result;
+	}
+
+	/*
+	* Generates a road-like graph: the nodes are scattered around the cells of a square lattice, and joined to their neighbors in the lattice
+	* with some of the edges missing and a few diagonals, weighted by their length. The graph is then planar-like, with a low degree and a geometry.
+	*
+	* @param	n	the approximate number of nodes, rounded down to a square
+	* @param	scale	the weight of an edge per unit of length, that must be at least 1 for the geometric heuristics to stay admissible
+	* @param	seed	the seed
+	* @return	the graph, with the coordinates of the nodes
+	*/
+	template <typename W = uint_fast32_t>
+	EdgeList<W> road_graph(size_t n, double scale = 100, uint64_t seed = 1) {
+		auto rng = mt19937_64(seed);
+		auto jitter = uniform_real_distribution<double>(-0.35, 0.35);
+		auto chance = uniform_real_distribution<double>(0, 1);
+		const auto side = static_cast<size_t>(sqrt(double(n)));
+		auto result = EdgeList<W>{ side * side, {}, {} };
+
+		result.coordinates.reserve(side * side);
+		for (size_t y = 0; y < side; ++y)
+			for (size_t x = 0; x < side; ++x)
+				result.coordinates.push_back({ x + jitter(rng), y + jitter(rng) });
+
+		auto join = [&](vertex_id u, vertex_id v) {
+			const auto dx = result.coordinates[u].x - result.coordinates[v].x;
+			const auto dy = result.coordinates[u].y - result.coordinates[v].y;
+
+			result.edges.emplace_back(u, v, max<W>(1, static_cast<W>(ceil(sqrt(dx * dx + dy * dy) * scale))));
+		};
+
+		for (size_t y = 0; y < side; ++y)
+			for (size_t x = 0; x < side; ++x) {
+				const auto v = static_cast<vertex_id>(y * side + x);
+
+				if (x + 1 < side && chance(rng) < 0.9)
+					join(v, v + 1);
+				if (y + 1 < side && chance(rng) < 0.9)
+					join(v, static_cast<vertex_id>(v + side));
+				if (x + 1 < side && y + 1 < side && chance(rng) < 0.1)
+					join(v, static_cast<vertex_id>(v + side + 1));
+			}
+
+		return result;
+	}
+
+	/*
+	* Builds a Graph from a generated graph, labelling each node with its identifier.
+	*
+	* @param	list	the generated graph
+	* @param	_or	the edge orientation
+	* @param	resource	the memory resource of the edges
+	* @return	the graph, whose identifiers are those of the generated graph
+	*/
+	template <typename W>
+	Graph<W> to_graph(const EdgeList<W>& list, Orientation _or = Orientation::UNORIENTED, pmr::memory_resource* resource = pmr::get_default_resource()) {
+		auto graph = Graph<W>(_or, resource);
+
+		for (size_t v = 0; v < list.n; ++v)
+			graph.add_node(to_string(v));
+		for (size_t v = 0; v < list.coordinates.size(); ++v)
+			graph.set_coordinates(static_cast<vertex_id>(v), list.coordinates[v]);
+		for (const auto& [u, v, weight] : list.edges)
+			graph.add_edge(u, v, weight);
+
+		return graph;
+	}
+};
+
+#endif
@@ -0,0 +1,151 @@
+#include <cstdint>
+#include <map>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "generators.hpp"
+#include "graph.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Benchmarks of the walks, lookups, set algebra and construction of graph.hpp in both edge layouts, the trees of the standard library against the sorted vectors of flat_container,
+ *	over the random graphs of generators.hpp. They live apart from benchmarks.cpp, whose helpers would clash with the namespace graph.
+ */
+
+using weight_type = unsigned int;
+
+template <graph::edge_layout layout>
+using layout_graph = graph::graph<graph::not_significative, graph::unique_vertices, graph::unique_edges, graph::weighted, graph::oriented, unsigned int, weight_type, layout>;
+
+/*
+ * Builds a random graph with n nodes and 4n edges in a layout, once per layout and size.
+ */
+template <graph::edge_layout layout>
+static const layout_graph<layout>& random_layout_graph(size_t n) {
+	static auto cache = std::map<size_t, layout_graph<layout>>();
+	auto it = cache.find(n);
+
+	if (it == cache.end()) {
+		const auto list = dijkstra::generators::random_graph<weight_type>(n, 4 * n);
+		auto g = layout_graph<layout>();
+
+		for (size_t v = 0; v < list.n; ++v)
+			g.add_vertex();
+		for (const auto& [u, v, weight] : list.edges)
+			g.add_edge(u, v, weight);
+
+		it = cache.emplace(n, std::move(g)).first;
+	}
+
+	return it->second;
+}
+
+/*
+ * Registers every size.
+ */
+static void layout_sizes(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({ "n" });
+
+	for (const auto n : { 1 << 10, 1 << 13, 1 << 16, 1 << 19 })
+		benchmark->Args({ n });
+}
+
+/* TRAVERSAL */
+
+template <graph::edge_layout layout>
+static void walk(benchmark::State& state) {
+	const auto& g = random_layout_graph<layout>(state.range(0));
+	size_t edges = 0;
+
+	for (auto _ : state) {
+		uint64_t total = 0;
+		edges = 0;
+
+		for (size_t v = 0; v < g.size(); ++v)
+			for (const auto& [neighbor, weight] : g.neighbors(v)) {
+				total += neighbor + weight;
+				++edges;
+			}
+
+		benchmark::DoNotOptimize(total);
+	}
+
+	state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK_TEMPLATE(walk, graph::tree_edges)->Apply(layout_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(walk, graph::flat_edges)->Apply(layout_sizes)->Unit(benchmark::kMicrosecond);
+
+template <graph::edge_layout layout>
+static void adjacent(benchmark::State& state) {
+	const auto& g = random_layout_graph<layout>(state.range(0));
+	const auto n = g.size();
+	size_t i = 0;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(g.adjacent(i % n, (i * 7919) % n));
+		++i;
+	}
+}
+BENCHMARK_TEMPLATE(adjacent, graph::tree_edges)->Apply(layout_sizes);
+BENCHMARK_TEMPLATE(adjacent, graph::flat_edges)->Apply(layout_sizes);
+
+/* SET ALGEBRA */
+
+template <graph::edge_layout layout>
+static void unite(benchmark::State& state) {
+	const auto& g = random_layout_graph<layout>(state.range(0));
+	// another version of the graph, with half of its edges removed and as many new ones
+	auto other = g;
+	const auto list = dijkstra::generators::random_graph<weight_type>(g.size(), 2 * g.size(), 100, 2);
+
+	for (size_t v = 0; v < other.size(); v += 2)
+		while (!other.neighbors(v).empty())
+			other.remove_edge(v, other.neighbors(v).begin()->first);
+	for (const auto& [u, v, weight] : list.edges)
+		other.add_edge(u, v, weight);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto result = g;
+		state.ResumeTiming();
+
+		result |= other;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK_TEMPLATE(unite, graph::tree_edges)->Apply(layout_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(unite, graph::flat_edges)->Apply(layout_sizes)->Unit(benchmark::kMillisecond);
+
+template <graph::edge_layout layout>
+static void equal(benchmark::State& state) {
+	const auto& g = random_layout_graph<layout>(state.range(0));
+	const auto copy = g;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(g == copy);
+}
+BENCHMARK_TEMPLATE(equal, graph::tree_edges)->Apply(layout_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(equal, graph::flat_edges)->Apply(layout_sizes)->Unit(benchmark::kMicrosecond);
+
+/* CONSTRUCTION */
+
+template <graph::edge_layout layout>
+static void add_edges(benchmark::State& state) {
+	const auto list = dijkstra::generators::random_graph<weight_type>(state.range(0), 4 * state.range(0));
+
+	for (auto _ : state) {
+		auto g = layout_graph<layout>();
+
+		for (size_t v = 0; v < list.n; ++v)
+			g.add_vertex();
+		for (const auto& [u, v, weight] : list.edges)
+			g.add_edge(u, v, weight);
+
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * list.edges.size());
+}
+BENCHMARK_TEMPLATE(add_edges, graph::tree_edges)->Apply(layout_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(add_edges, graph::flat_edges)->Apply(layout_sizes)->Unit(benchmark::kMillisecond);
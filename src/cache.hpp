@@ -0,0 +1,194 @@
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "dijkstra.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description A cache of the shortest paths found by Graph::find(), for the request mixes that ask for the same pairs of nodes over and over.
+ */
+namespace dijkstra {
+	using namespace std;
+
+	/*
+	* A bounded cache of paths keyed by their source and destination, that evicts the least recently used path of a shard once it is full.
+	* The pairs are spread over shards, each with its own lock, so that concurrent queries rarely wait for each other.
+	* The paths are dropped as soon as the version of the graph changes; the graph must not change during a query, as with Graph::find().
+	*
+	* @param	W	the type of the weights
+	* @param	Queue	the priority queue policy of the searches on a miss, among the ones of heaps.hpp
+	*/
+	template <typename W = uint_fast32_t, template <typename> class Queue = FibonacciHeap>
+	class PathCache {
+		private:
+			/*
+			* The number of shards, a power of two.
+			*/
+			static constexpr size_t shard_bits = 4;
+			static constexpr size_t shard_count = size_t(1) << shard_bits;
+
+			/*
+			* The multiplier of the Fibonacci hashing of the pairs into the shards, that spreads the pairs sharing a source or a destination.
+			*/
+			static constexpr uint64_t golden = 0x9E3779B97F4A7C15;
+
+			/*
+			* A part of the cache, on its own cache line to avoid false sharing.
+			* - entries : the pairs and their paths, from the most to the least recently used
+			* - index : the position of each pair in entries
+			* - version : the version of the graph the paths were found in
+			*/
+			struct alignas(64) Shard {
+				mutex lock;
+				list<pair<uint64_t, Path<W>>> entries;
+				unordered_map<uint64_t, typename list<pair<uint64_t, Path<W>>>::iterator> index;
+				uint64_t version = 0;
+			};
+
+			const Graph<W>& graph;
+			size_t shard_capacity;
+			unique_ptr<Shard[]> shards;
+			atomic<uint64_t> _hits;
+			atomic<uint64_t> _misses;
+
+		public:
+			/*
+			* Constructor.
+			*
+			* @param	graph	the graph, whose version is checked at each query
+			* @param	capacity	the number of paths kept at most, rounded up to a multiple of the number of shards
+			*/
+			PathCache(const Graph<W>& graph, size_t capacity) : graph(graph), shard_capacity((capacity + shard_count - 1) / shard_count),
+				shards(make_unique<Shard[]>(shard_count)), _hits(0), _misses(0) {
+				assert(("The capacity of the cache is null", capacity != 0));
+			}
+
+			PathCache(const PathCache&) = delete;
+			PathCache& operator=(const PathCache&) = delete;
+
+			/*
+			* Finds the shortest path between two nodes, asserting it exists, from the cache or with Graph::find().
+			*
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	mode	the initialisation of the heap on a miss
+			* @return	a path that starts with src and ends with dst
+			*/
+			Path<W> find(string_view src, string_view dst, Insertion mode = Insertion::EAGER) {
+				return find(graph.id(src), graph.id(dst), mode);
+			}
+
+			/*
+			* Finds the shortest path between two nodes, asserting it exists, from the cache or with Graph::find().
+			*
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	mode	the initialisation of the heap on a miss
+			* @return	a path that starts with src and ends with dst
+			*/
+			Path<W> find(vertex_id src, vertex_id dst, Insertion mode = Insertion::EAGER) {
+				const auto key = (static_cast<uint64_t>(src) << 32) | dst;
+				const auto version = graph.get_version();
+				auto& shard = shards[((key ^ (key >> 32)) * golden) >> (64 - shard_bits)];
+
+				{
+					lock_guard<mutex> guard(shard.lock);
+					invalidate(shard, version);
+
+					if (auto it = shard.index.find(key); it != shard.index.end()) {
+						shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+						++_hits;
+
+						return it->second->second;
+					}
+				}
+
+				// the search runs without the lock, so that the other queries of the shard go on meanwhile
+				++_misses;
+				auto _path = graph.template find<Queue>(src, dst, mode);
+
+				lock_guard<mutex> guard(shard.lock);
+				invalidate(shard, version);
+
+				// another query may have found the same path meanwhile
+				if (shard.index.find(key) == shard.index.end()) {
+					shard.entries.emplace_front(key, _path);
+					shard.index.emplace(key, shard.entries.begin());
+
+					if (shard.entries.size() > shard_capacity) {
+						shard.index.erase(shard.entries.back().first);
+						shard.entries.pop_back();
+					}
+				}
+
+				return _path;
+			}
+
+			/*
+			* Drops every path.
+			*/
+			void clear() {
+				for (size_t i = 0; i < shard_count; ++i) {
+					lock_guard<mutex> guard(shards[i].lock);
+					shards[i].entries.clear();
+					shards[i].index.clear();
+				}
+			}
+
+			/*
+			* Returns the number of paths in the cache, including the ones of an older version not dropped yet.
+			*/
+			size_t size() const {
+				size_t result = 0;
+
+				for (size_t i = 0; i < shard_count; ++i) {
+					lock_guard<mutex> guard(shards[i].lock);
+					result += shards[i].entries.size();
+				}
+
+				return result;
+			}
+
+			/*
+			* Returns the number of queries answered from the cache.
+			*/
+			inline uint64_t hits() const noexcept {
+				return _hits.load(memory_order_relaxed);
+			}
+
+			/*
+			* Returns the number of queries that ran a search.
+			*/
+			inline uint64_t misses() const noexcept {
+				return _misses.load(memory_order_relaxed);
+			}
+
+		private:
+			/*
+			* Drops the paths of a shard if they were found in another version of the graph.
+			*
+			* @param	shard	the shard, whose lock is held
+			* @param	version	the current version of the graph
+			*/
+			static inline void invalidate(Shard& shard, uint64_t version) {
+				if (shard.version != version) {
+					shard.entries.clear();
+					shard.index.clear();
+					shard.version = version;
+				}
+			}
+	};
+};
+
+#endif
@@ -0,0 +1,535 @@
+#ifndef CONTRACTION_HPP
+#define CONTRACTION_HPP
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dijkstra.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Contraction Hierarchies, that preprocess a Graph once to answer shortest path queries by settling only a few hundred nodes.
+ *	The nodes are contracted one after the other by increasing importance: contracting a node removes it from the graph,
+ *	and adds a shortcut between two of its neighbors whenever the path through it is the only shortest one, which a bounded witness search checks.
+ *	A query then runs two searches that only follow the edges towards more important nodes, one forward from the source and one backward from the destination.
+ * @cite	@inproceedings{geisberger2008contraction, title={Contraction hierarchies: Faster and simpler hierarchical routing in road networks}, author={Geisberger, Robert and Sanders, Peter and Schultes, Dominik and Delling, Daniel}, booktitle={International Workshop on Experimental and Efficient Algorithms}, pages={319--333}, year={2008}}
+ */
+namespace dijkstra {
+	using namespace std;
+
+	/*
+	* A contraction hierarchy built from a graph, that gives the same distances as Graph::find() and does not follow its later changes.
+	* The preprocessing runs in rounds: each round contracts in parallel a set of nodes that are less important than all their neighbors,
+	* so that the nodes contracted together are never adjacent.
+	*
+	* @param	W	the type of the weights
+	*/
+	template <typename W = uint_fast32_t>
+	class ContractionHierarchy {
+		public:
+			/*
+			* The state of a search in one direction, cleared in time proportional to the nodes it has discovered rather than to the size of the graph.
+			*/
+			struct Search {
+				DaryHeap<W, 4> queue;
+				vector<W> distances;
+				vector<vertex_id> preds;
+				vector<vertex_id> discovered;
+
+				/*
+				* Prepares a new search from a source.
+				*
+				* @param	n	the number of nodes
+				* @param	src	the identifier of the source node
+				*/
+				void reset(size_t n, vertex_id src) {
+					for (const auto v : discovered)
+						distances[v] = numeric_limits<W>::max();
+					discovered.clear();
+					queue.reset(n);
+
+					if (distances.size() < n) {
+						distances.resize(n, numeric_limits<W>::max());
+						preds.resize(n);
+					}
+
+					relax(static_cast<vertex_id>(n), src, 0);
+				}
+
+				/*
+				* Pushes a node or decreases its distance if alt is shorter.
+				*
+				* @param	pred	the node from which the edge is relaxed
+				* @param	v	the node at the end of the edge
+				* @param	alt	the distance of v through pred
+				*/
+				inline void relax(vertex_id pred, vertex_id v, W alt) {
+					if (alt < distances[v]) {
+						if (distances[v] == numeric_limits<W>::max())
+							discovered.push_back(v);
+
+						distances[v] = alt;
+						preds[v] = pred;
+						queue.push(v, alt);
+					}
+				}
+			};
+
+			/*
+			* The state of a query, that a caller can keep to run several queries without allocating again.
+			*/
+			struct Query {
+				Search forward;
+				Search backward;
+			};
+
+		private:
+			/*
+			* An edge towards or from a node, that is a shortcut if middle is a node, or an original edge if it is the number of nodes.
+			*/
+			struct Arc {
+				vertex_id node;
+				W weight;
+				vertex_id middle;
+			};
+
+			/*
+			* The number of nodes a witness search settles at most, beyond which a shortcut is added even if it may be useless.
+			*/
+			static constexpr size_t witness_limit = 500;
+
+			size_t n = 0;
+			vector<string> labels;
+			// the keys view the labels, that are never resized once the hierarchy is built
+			unordered_map<string_view, vertex_id> ids;
+			vector<vertex_id> ranks;
+			vector<uint64_t> up_offsets;
+			vector<Arc> up;
+			vector<uint64_t> down_offsets;
+			vector<Arc> down;
+
+		public:
+			/*
+			* Constructor, that contracts every node of a graph.
+			*
+			* @param	graph	the graph
+			* @param	pool	the thread pool running the witness searches
+			*/
+			ContractionHierarchy(const Graph<W>& graph, ThreadPool& pool) : n(graph.get_nodes().size()) {
+				labels.reserve(n);
+				for (vertex_id v = 0; v < n; ++v) {
+					labels.push_back(graph.contains(v) ? graph.label(v) : string());
+					if (graph.contains(v))
+						ids.emplace(labels.back(), v);
+				}
+
+				contract(graph, pool);
+			}
+
+			/*
+			* Constructor, that contracts every node of a graph on a temporary thread pool.
+			*
+			* @param	graph	the graph
+			* @param	threads	the number of threads
+			*/
+			explicit ContractionHierarchy(const Graph<W>& graph, size_t threads = thread::hardware_concurrency()) : ContractionHierarchy(graph, ThreadPool(threads)) {}
+
+			/*
+			* Copy constructor.
+			*/
+			ContractionHierarchy(const ContractionHierarchy& other) : n(other.n), labels(other.labels), ranks(other.ranks),
+				up_offsets(other.up_offsets), up(other.up), down_offsets(other.down_offsets), down(other.down) {
+				// the keys must view the labels of the copy
+				ids.reserve(other.ids.size());
+				for (const auto& [_, v] : other.ids)
+					ids.emplace(labels[v], v);
+			}
+
+			ContractionHierarchy(ContractionHierarchy&&) noexcept = default;
+
+			/*
+			* Copy assignment.
+			*/
+			ContractionHierarchy& operator=(const ContractionHierarchy& other) {
+				return *this = ContractionHierarchy(other);
+			}
+
+			ContractionHierarchy& operator=(ContractionHierarchy&&) noexcept = default;
+
+			/*
+			* Returns the number of nodes, including the removed ones of the original graph.
+			*/
+			inline size_t size() const noexcept {
+				return n;
+			}
+
+			/*
+			* Returns the number of edges of the upward and downward graphs, original edges and shortcuts.
+			*/
+			inline size_t edge_count() const noexcept {
+				return up.size() + down.size();
+			}
+
+			/*
+			* Returns the rank of a node in the hierarchy, where the nodes contracted first have the lowest ranks.
+			*
+			* @param	v	the identifier
+			* @return	the rank
+			*/
+			inline vertex_id rank(vertex_id v) const {
+				return ranks.at(v);
+			}
+
+			/*
+			* Finds the shortest path between two nodes, asserting it exists.
+			*
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @return	a path that starts with src and ends with dst, with every shortcut unpacked
+			*/
+			Path<W> find(string_view src, string_view dst) const {
+				auto query = Query();
+
+				return find(src, dst, query);
+			}
+
+			/*
+			* Finds the shortest path between two nodes, asserting it exists, reusing the state of a previous query.
+			*
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	query	the state of the query
+			* @return	a path that starts with src and ends with dst, with every shortcut unpacked
+			*/
+			Path<W> find(string_view src, string_view dst, Query& query) const {
+				assert(("The source and destination are the same", dst != src));
+
+				const auto [distance, meeting] = search(ids.at(src), ids.at(dst), query);
+				if (distance == numeric_limits<W>::max())
+					throw out_of_range("There is no path between the source and destination");
+
+				// the upward path from src to the meeting node, then the downward one to dst
+				auto _path = vector<vertex_id>{ meeting };
+				while (_path.back() != ids.at(src))
+					_path.push_back(query.forward.preds[_path.back()]);
+				reverse(_path.begin(), _path.end());
+				while (_path.back() != ids.at(dst))
+					_path.push_back(query.backward.preds[_path.back()]);
+
+				auto vertices = vector<vertex_id>{ _path.front() };
+				auto distances = vector<W>{ 0 };
+				for (size_t i = 0; i + 1 < _path.size(); ++i)
+					unpack(_path[i], _path[i + 1], vertices, distances);
+
+				return Path<W>(move(vertices), move(distances));
+			}
+
+			/*
+			* Returns the label of a node.
+			*
+			* @param	v	the identifier, that must exist
+			* @return	the label
+			*/
+			inline const string& label(vertex_id v) const {
+				return labels.at(v);
+			}
+
+			/*
+			* Returns the distance between two nodes.
+			*
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	query	the state of the query
+			* @return	the distance, or numeric_limits<W>::max() if dst is unreachable
+			*/
+			W distance(string_view src, string_view dst, Query& query) const {
+				return get<0>(search(ids.at(src), ids.at(dst), query));
+			}
+
+			/*
+			* Returns the distance between two nodes.
+			*
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @return	the distance, or numeric_limits<W>::max() if dst is unreachable
+			*/
+			W distance(string_view src, string_view dst) const {
+				auto query = Query();
+
+				return distance(src, dst, query);
+			}
+
+		private:
+			/*
+			* Delegating target of the constructor over a temporary thread pool.
+			*/
+			ContractionHierarchy(const Graph<W>& graph, ThreadPool&& pool) : ContractionHierarchy(graph, pool) {}
+
+			/*
+			* Runs the two upward searches, settling the nearest node of both until no shorter path can be found.
+			*
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	query	the state of the query
+			* @return	the distance, and the node where the shortest path goes from the upward search to the downward one
+			*/
+			pair<W, vertex_id> search(vertex_id src, vertex_id dst, Query& query) const {
+				auto best = numeric_limits<W>::max();
+				auto meeting = static_cast<vertex_id>(n);
+
+				query.forward.reset(n, src);
+				query.backward.reset(n, dst);
+
+				while (!query.forward.queue.empty() || !query.backward.queue.empty()) {
+					const bool is_forward = !query.forward.queue.empty()
+						&& (query.backward.queue.empty() || query.forward.queue.top().second <= query.backward.queue.top().second);
+					auto& search = is_forward ? query.forward : query.backward;
+					const auto& other = is_forward ? query.backward : query.forward;
+					const auto& offsets = is_forward ? up_offsets : down_offsets;
+					const auto& arcs = is_forward ? up : down;
+					const auto [nearest, distance] = search.queue.top();
+
+					// the searches do not stop when they meet, as the upward paths can be longer than the shortest one
+					if (distance >= best)
+						break;
+
+					search.queue.pop();
+					if (other.distances[nearest] != numeric_limits<W>::max() && distance + other.distances[nearest] < best) {
+						best = distance + other.distances[nearest];
+						meeting = nearest;
+					}
+
+					for (size_t e = offsets[nearest]; e < offsets[nearest + 1]; ++e)
+						search.relax(nearest, arcs[e].node, distance + arcs[e].weight);
+				}
+
+				return { best, meeting };
+			}
+
+			/*
+			* Appends the nodes of the original path behind an edge or a shortcut, after its first node, with their distances from the source.
+			*
+			* @param	from	the first node, already at the end of the path
+			* @param	to	the last node
+			* @param	vertices	the nodes of the path
+			* @param	distances	the distance of each node of the path
+			*/
+			void unpack(vertex_id from, vertex_id to, vector<vertex_id>& vertices, vector<W>& distances) const {
+				auto stack = vector<pair<vertex_id, vertex_id>>{ { from, to } };
+
+				while (!stack.empty()) {
+					const auto [u, w] = stack.back();
+					stack.pop_back();
+
+					const auto& a = arc(u, w);
+					const auto middle = a.middle;
+					if (middle == n) {
+						vertices.push_back(w);
+						distances.push_back(distances.back() + a.weight);
+					}
+					else {
+						stack.emplace_back(middle, w);
+						stack.emplace_back(u, middle);
+					}
+				}
+			}
+
+			/*
+			* Returns the edge or shortcut between two nodes, which is stored with its least important end.
+			*/
+			const Arc& arc(vertex_id u, vertex_id w) const {
+				const bool is_up = ranks[u] < ranks[w];
+				const auto& offsets = is_up ? up_offsets : down_offsets;
+				const auto& arcs = is_up ? up : down;
+				const auto owner = is_up ? u : w, other = is_up ? w : u;
+
+				return *lower_bound(arcs.begin() + offsets[owner], arcs.begin() + offsets[owner + 1], other,
+					[](const Arc& lhs, vertex_id v) { return lhs.node < v; });
+			}
+
+			/*
+			* Contracts every node, and stores the edges of each one towards the more important nodes.
+			*
+			* @param	graph	the graph
+			* @param	pool	the thread pool running the witness searches
+			*/
+			void contract(const Graph<W>& graph, ThreadPool& pool) {
+				auto out = vector<vector<Arc>>(n);
+				auto in = vector<vector<Arc>>(n);
+				for (vertex_id v = 0; v < n; ++v)
+					for (const auto& [neighbor, weight] : graph.get_nodes()[v].neighbors)
+						if (neighbor != v) {
+							out[v].push_back({ neighbor, weight, static_cast<vertex_id>(n) });
+							in[neighbor].push_back({ v, weight, static_cast<vertex_id>(n) });
+						}
+
+				auto remaining = vector<vertex_id>();
+				for (vertex_id v = 0; v < n; ++v)
+					if (graph.contains(v))
+						remaining.push_back(v);
+
+				auto searches = vector<Search>(pool.size());
+				auto priorities = vector<int64_t>(n, 0);
+				auto contracted_neighbors = vector<int64_t>(n, 0);
+				auto contracting = vector<char>(n, false);
+				auto stale = remaining;
+				vertex_id next_rank = 0;
+				ranks.assign(n, static_cast<vertex_id>(n));
+
+				// the importance of a node is its edge difference, plus its contracted neighbors to spread the contraction evenly
+				auto prioritize = [&](const vector<vertex_id>& nodes) {
+					pool.parallel_for(nodes.size(), [&](size_t i, size_t worker) {
+						const auto v = nodes[i];
+						const auto shortcuts = witness(v, out, in, contracting, searches[worker], [](vertex_id, vertex_id, W) {});
+
+						priorities[v] = static_cast<int64_t>(shortcuts) - static_cast<int64_t>(in[v].size() + out[v].size()) + contracted_neighbors[v];
+					});
+				};
+
+				auto less_important = [&](vertex_id lhs, vertex_id rhs) {
+					return make_pair(priorities[lhs], lhs) < make_pair(priorities[rhs], rhs);
+				};
+
+				auto selected = vector<vertex_id>();
+				auto shortcuts = vector<vector<tuple<vertex_id, vertex_id, W>>>();
+				auto is_stale = vector<char>(n, false);
+
+				while (!remaining.empty()) {
+					prioritize(stale);
+
+					// the nodes less important than all their neighbors are independent
+					selected.clear();
+					for (const auto v : remaining)
+						if (all_of(out[v].begin(), out[v].end(), [&](const Arc& a) { return less_important(v, a.node); })
+							&& all_of(in[v].begin(), in[v].end(), [&](const Arc& a) { return less_important(v, a.node); }))
+							selected.push_back(v);
+
+					for (const auto v : selected)
+						contracting[v] = true;
+
+					shortcuts.assign(selected.size(), {});
+					pool.parallel_for(selected.size(), [&](size_t i, size_t worker) {
+						witness(selected[i], out, in, contracting, searches[worker], [&](vertex_id u, vertex_id w, W weight) {
+							shortcuts[i].emplace_back(u, w, weight);
+						});
+					});
+
+					stale.clear();
+					for (size_t i = 0; i < selected.size(); ++i) {
+						const auto v = selected[i];
+						ranks[v] = next_rank++;
+
+						for (const auto& a : out[v]) {
+							erase(in[a.node], v);
+							++contracted_neighbors[a.node];
+							if (!is_stale[a.node])
+								stale.push_back(a.node);
+							is_stale[a.node] = true;
+						}
+						for (const auto& a : in[v]) {
+							erase(out[a.node], v);
+							++contracted_neighbors[a.node];
+							if (!is_stale[a.node])
+								stale.push_back(a.node);
+							is_stale[a.node] = true;
+						}
+
+						for (const auto& [u, w, weight] : shortcuts[i]) {
+							merge(out[u], w, weight, v);
+							merge(in[w], u, weight, v);
+						}
+					}
+
+					for (const auto v : stale)
+						is_stale[v] = false;
+
+					remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&](vertex_id v) { return contracting[v]; }), remaining.end());
+				}
+
+				// the edges of a node at its contraction all lead to more important nodes
+				up_offsets.assign(1, 0);
+				down_offsets.assign(1, 0);
+				for (vertex_id v = 0; v < n; ++v) {
+					sort(out[v].begin(), out[v].end(), [](const Arc& lhs, const Arc& rhs) { return lhs.node < rhs.node; });
+					sort(in[v].begin(), in[v].end(), [](const Arc& lhs, const Arc& rhs) { return lhs.node < rhs.node; });
+					up.insert(up.end(), out[v].begin(), out[v].end());
+					down.insert(down.end(), in[v].begin(), in[v].end());
+					up_offsets.push_back(up.size());
+					down_offsets.push_back(down.size());
+				}
+			}
+
+			/*
+			* Finds the shortcuts needed to contract a node: for every pair of neighbors u -> v -> w, a search from u that avoids the nodes being contracted
+			* looks for a path to w at most as long as the one through v.
+			*
+			* @param	v	the node
+			* @param	out	the outgoing edges of the remaining nodes
+			* @param	in	the incoming edges of the remaining nodes
+			* @param	contracting	the nodes contracted in the current round, that the witnesses avoid
+			* @param	search	the state of the witness search
+			* @param	add	called with every shortcut
+			* @return	the number of shortcuts
+			*/
+			template <class Visitor>
+			size_t witness(vertex_id v, const vector<vector<Arc>>& out, const vector<vector<Arc>>& in, const vector<char>& contracting, Search& search, Visitor&& add) const {
+				size_t count = 0;
+				W longest = 0;
+
+				for (const auto& a : out[v])
+					longest = max(longest, a.weight);
+
+				for (const auto& from : in[v]) {
+					const W limit = from.weight + longest;
+					size_t settled = 0;
+
+					search.reset(n, from.node);
+					while (!search.queue.empty() && search.queue.top().second <= limit && settled++ < witness_limit) {
+						const auto [nearest, distance] = search.queue.top();
+						search.queue.pop();
+
+						for (const auto& a : out[nearest])
+							if (a.node != v && !contracting[a.node])
+								search.relax(nearest, a.node, distance + a.weight);
+					}
+
+					for (const auto& to : out[v])
+						if (to.node != from.node && search.distances[to.node] > from.weight + to.weight) {
+							add(from.node, to.node, from.weight + to.weight);
+							++count;
+						}
+				}
+
+				return count;
+			}
+
+			/*
+			* Removes the edges towards or from a node.
+			*/
+			static inline void erase(vector<Arc>& arcs, vertex_id v) {
+				arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [v](const Arc& a) { return a.node == v; }), arcs.end());
+			}
+
+			/*
+			* Adds a shortcut, or shortens the edge between the same nodes.
+			*/
+			static inline void merge(vector<Arc>& arcs, vertex_id v, W weight, vertex_id middle) {
+				const auto it = find_if(arcs.begin(), arcs.end(), [v](const Arc& a) { return a.node == v; });
+
+				if (it == arcs.end())
+					arcs.push_back({ v, weight, middle });
+				else if (weight < it->weight)
+					*it = { v, weight, middle };
+			}
+	};
+};
+
+#endif
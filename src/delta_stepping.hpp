@@ -0,0 +1,303 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dijkstra.hpp"
+#include "thread_pool.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Delta-stepping, a parallel single-source shortest path algorithm for the one-to-all searches on large graphs.
+ *	The nodes are kept in buckets of width delta by their tentative distance, and the buckets are emptied in order.
+ *	The nodes of a bucket are all expanded at the same time: first along their light edges, no heavier than delta, which may put nodes back in the same bucket,
+ *	then along their heavy edges once the bucket stays empty, which can only fill the following buckets.
+ *	A small delta settles the nodes in the order of Dijkstra's algorithm with little parallelism, and a large one expands more nodes at once but some of them several times.
+ * @cite	@article{meyer2003delta, title={$\Delta$-stepping: a parallelizable shortest path algorithm}, author={Meyer, Ulrich and Sanders, Peter}, journal={Journal of Algorithms}, volume={49}, number={1}, pages={114--152}, year={2003}}
+ */
+namespace dijkstra {
+	using namespace std;
+
+	/*
+	* A delta-stepping engine built from a graph, that gives the same distances as Graph::shortest_path_tree() and does not follow its later changes.
+	* The edges are copied in compressed sparse row layout, the light edges of each node before its heavy ones.
+	* The weights must not be negative.
+	*
+	* @param	W	the type of the weights
+	*/
+	template <typename W = uint_fast32_t>
+	class DeltaStepping {
+		private:
+			// the number of nodes a worker takes at once, so that the parallel loops do not synchronize for every node
+			static constexpr size_t grain = 256;
+			// the most buckets a worker keeps, whatever the width of the buckets and the weights
+			static constexpr size_t max_buckets = size_t(1) << 12;
+
+			size_t n = 0;
+			W _delta = W();
+			// the edges of v are the ones in [offsets[v], offsets[v + 1]), of which the ones in [offsets[v], splits[v]) are light
+			vector<uint64_t> offsets;
+			vector<uint64_t> splits;
+			vector<vertex_id> targets;
+			vector<W> weights;
+			W max_weight = W();
+
+		public:
+			/*
+			* Constructor, that copies the edges of a graph on a thread pool.
+			*
+			* @param	graph	the graph
+			* @param	pool	the thread pool
+			* @param	delta	the width of the buckets, or 0 to derive it from the weights and the degrees
+			*/
+			DeltaStepping(const Graph<W>& graph, ThreadPool& pool, W delta = W()) : n(graph.get_nodes().size()), offsets(n + 1, 0), splits(n, 0) {
+				const auto& nodes = graph.get_nodes();
+
+				for (vertex_id v = 0; v < n; ++v) {
+					offsets[v + 1] = offsets[v] + nodes[v].neighbors.size();
+					for (const auto& [neighbor, weight] : nodes[v].neighbors)
+						max_weight = max(max_weight, weight);
+				}
+				targets.resize(offsets[n]);
+				weights.resize(offsets[n]);
+
+				_delta = delta > W() ? delta : suggest(max_weight, n ? double(offsets[n]) / n : 0);
+
+				pool.parallel_for((n + grain - 1) / grain, [&](size_t chunk, size_t) {
+					for (auto v = chunk * grain; v < min(n, (chunk + 1) * grain); ++v) {
+						auto e = offsets[v];
+
+						for (const auto is_light : { true, false }) {
+							for (const auto& [neighbor, weight] : nodes[v].neighbors)
+								if ((weight <= _delta) == is_light) {
+									targets[e] = neighbor;
+									weights[e++] = weight;
+								}
+							if (is_light)
+								splits[v] = e;
+						}
+					}
+				});
+			}
+
+			/*
+			* Constructor, that copies the edges of a graph on a temporary thread pool.
+			*
+			* @param	graph	the graph
+			* @param	delta	the width of the buckets, or 0 to derive it from the weights and the degrees
+			* @param	threads	the number of threads
+			*/
+			explicit DeltaStepping(const Graph<W>& graph, W delta = W(), size_t threads = thread::hardware_concurrency()) : DeltaStepping(graph, ThreadPool(threads), delta) {}
+
+			/*
+			* Returns the width of the buckets.
+			*/
+			inline W delta() const noexcept {
+				return _delta;
+			}
+
+			/*
+			* Returns the number of nodes, including the removed ones of the original graph.
+			*/
+			inline size_t size() const noexcept {
+				return n;
+			}
+
+			/*
+			* Returns the number of edges, counting both directions of an unoriented edge.
+			*/
+			inline size_t edge_count() const noexcept {
+				return targets.size();
+			}
+
+			/*
+			* Computes the distances from a node to all the others on a temporary thread pool.
+			*
+			* @param	src	the identifier of the source node
+			* @param	threads	the number of threads
+			* @return	the distance of every node, numeric_limits<W>::max() for the ones unreachable from src
+			*/
+			vector<W> distances(vertex_id src, size_t threads = thread::hardware_concurrency()) const {
+				auto pool = ThreadPool(threads);
+
+				return distances(src, pool);
+			}
+
+			/*
+			* Computes the distances from a node to all the others on a thread pool.
+			*
+			* @param	src	the identifier of the source node
+			* @param	pool	the thread pool, whose workers all relax edges
+			* @return	the distance of every node, numeric_limits<W>::max() for the ones unreachable from src
+			*/
+			vector<W> distances(vertex_id src, ThreadPool& pool) const {
+				assert(("The source node is not in the graph", src < n));
+
+				const auto chunks = (n + grain - 1) / grain;
+				// a relaxation from the bucket i reaches at most the bucket i + max_weight / delta + 1, so that the buckets can be reused cyclically;
+				// the ring holds the buckets [i, i + ring), and the nodes beyond wait in the overflow of each worker when delta is small against the weights
+				const auto ring = static_cast<size_t>(min<W>(max_weight / _delta, W(max_buckets - 2))) + 2;
+				auto tentative = make_unique<atomic<W>[]>(n);
+				// the buckets of each worker, so that they fill them without synchronizing
+				auto buckets = vector<vector<vector<vertex_id>>>(pool.size(), vector<vector<vertex_id>>(ring));
+				auto overflow = vector<vector<vertex_id>>(pool.size());
+				// the last phase in which a node has been put in the frontier, and the last bucket in which it has been expanded plus one
+				auto in_frontier = vector<uint64_t>(n, 0);
+				auto in_bucket = vector<uint64_t>(n, 0);
+				auto frontier = vector<vertex_id>(), expanded = vector<vertex_id>();
+				uint64_t phase = 0;
+				size_t i = 0;
+
+				pool.parallel_for(chunks, [&](size_t chunk, size_t) {
+					for (auto v = chunk * grain; v < min(n, (chunk + 1) * grain); ++v)
+						tentative[v].store(numeric_limits<W>::max(), memory_order_relaxed);
+				});
+
+				auto index = [this](W distance) { return static_cast<size_t>(distance / _delta); };
+				auto relax = [&](vertex_id v, W alt, size_t worker) {
+					auto current = tentative[v].load(memory_order_relaxed);
+
+					while (alt < current)
+						if (tentative[v].compare_exchange_weak(current, alt, memory_order_relaxed)) {
+							const auto bucket = index(alt);
+
+							if (bucket < i + ring)
+								buckets[worker][bucket % ring].push_back(v);
+							else
+								overflow[worker].push_back(v);
+							return;
+						}
+				};
+				// moves the nodes of the overflow whose bucket is now in the ring, and drops the ones whose distance has decreased since, returning whether it moved any
+				auto refill = [&]() {
+					auto moved = false;
+
+					for (size_t worker = 0; worker < overflow.size(); ++worker) {
+						auto& local = overflow[worker];
+						size_t kept = 0;
+
+						for (const auto v : local) {
+							const auto bucket = index(tentative[v].load(memory_order_relaxed));
+
+							if (bucket >= i + ring)
+								local[kept++] = v;
+							else if (bucket >= i) {
+								buckets[worker][bucket % ring].push_back(v);
+								moved = true;
+							}
+						}
+						local.resize(kept);
+					}
+
+					return moved;
+				};
+				// expands every node of a list along the edges of [offsets[v], splits[v]) or [splits[v], offsets[v + 1])
+				auto expand = [&](const vector<vertex_id>& nodes, bool is_light) {
+					pool.parallel_for((nodes.size() + grain - 1) / grain, [&](size_t chunk, size_t worker) {
+						for (auto j = chunk * grain; j < min(nodes.size(), (chunk + 1) * grain); ++j) {
+							const auto u = nodes[j];
+							const auto distance = tentative[u].load(memory_order_relaxed);
+
+							for (auto e = is_light ? offsets[u] : splits[u]; e < (is_light ? splits[u] : offsets[u + 1]); ++e)
+								relax(targets[e], distance + weights[e], worker);
+						}
+					});
+				};
+
+				tentative[src].store(W(), memory_order_relaxed);
+				buckets[0][0].push_back(src);
+
+				// the number of buckets since the last push in the ring, so that the whole ring is empty once it reaches its size
+				for (size_t empty = 0;; ++i) {
+					if (empty == ring) {
+						// the whole ring is empty: the search jumps to the nearest bucket of the overflow, if any, skipping the nodes settled since they were put in it
+						auto next = numeric_limits<size_t>::max();
+						for (const auto& local : overflow)
+							for (const auto v : local)
+								if (const auto bucket = index(tentative[v].load(memory_order_relaxed)); bucket >= i)
+									next = min(next, bucket);
+
+						if (next == numeric_limits<size_t>::max())
+							break;
+
+						i = next;
+						empty = 0;
+						refill();
+					}
+					else if (i % ring == 0 && refill())
+						empty = 0;
+
+					const auto slot = i % ring;
+
+					expanded.clear();
+					while (true) {
+						// gathers the nodes still in the bucket i, skipping those whose distance has decreased since they were put in it
+						++phase;
+						frontier.clear();
+						for (auto& local : buckets) {
+							for (const auto v : local[slot])
+								if (in_frontier[v] != phase && index(tentative[v].load(memory_order_relaxed)) == i) {
+									in_frontier[v] = phase;
+									frontier.push_back(v);
+									if (in_bucket[v] != i + 1) {
+										in_bucket[v] = i + 1;
+										expanded.push_back(v);
+									}
+								}
+							local[slot].clear();
+						}
+
+						if (frontier.empty())
+							break;
+						expand(frontier, true);
+					}
+
+					if (expanded.empty())
+						++empty;
+					else {
+						empty = 0;
+						expand(expanded, false);
+					}
+				}
+
+				auto result = vector<W>(n);
+				pool.parallel_for(chunks, [&](size_t chunk, size_t) {
+					for (auto v = chunk * grain; v < min(n, (chunk + 1) * grain); ++v)
+						result[v] = tentative[v].load(memory_order_relaxed);
+				});
+
+				return result;
+			}
+
+		private:
+			/*
+			* Constructor, that copies the edges of a graph on a temporary thread pool.
+			*
+			* @param	graph	the graph
+			* @param	pool	the temporary thread pool
+			* @param	delta	the width of the buckets
+			*/
+			DeltaStepping(const Graph<W>& graph, ThreadPool&& pool, W delta) : DeltaStepping(graph, pool, delta) {}
+
+			/*
+			* Derives the width of the buckets from the heaviest weight and the average degree, so that a bucket holds about one edge weight per neighbor.
+			*
+			* @param	max_weight	the heaviest weight
+			* @param	degree	the average degree
+			* @return	the width of the buckets, that is positive
+			*/
+			static W suggest(W max_weight, double degree) {
+				const auto delta = static_cast<W>(double(max_weight) / max(degree, 1.0));
+
+				return delta > W() ? delta : W(1);
+			}
+	};
+};
+
+#endif
@@ -2,29 +2,37 @@
 #define DIJKSTRA_HPP
 
 #include <algorithm>
+#include <array>
 #include <cassert>
-#include <filesystem>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <numeric>
 #include <optional>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "boost/heap/fibonacci_heap.hpp"
+#include "heaps.hpp"
+#include "thread_pool.hpp"
 
 /*
  * @author Antoine Sébert
- * @description Implementation of Dijkstra's algorithm in C++17 as a single header library using a fibonacci heap.
+ * @description Implementation of Dijkstra's algorithm in C++17 as a header library, using a fibonacci heap or any other priority queue policy of heaps.hpp.
  */
 namespace dijkstra {
 	using namespace std;
-	using namespace boost::heap;
-	namespace fs = std::filesystem;
 
 	/*
 	* The orientation of a graph. Has an impact on edge insertion and deletion.
@@ -34,12 +42,1199 @@ namespace dijkstra {
 		UNORIENTED,
 	};
 
+	/*
+	* The initialisation of the heap when a search starts.
+	* - EAGER : every node is pushed into the heap before the search starts
+	* - LAZY : only the source is pushed, and the other nodes are pushed when they are discovered
+	*/
+	enum class Insertion : uint8_t {
+		EAGER,
+		LAZY,
+	};
+
+	/*
+	* The phases of a query, timed separately by the statistics.
+	* - INITIALISATION : the reset of the workspace, and the insertion of every node with Insertion::EAGER
+	* - SEARCH : the settlement of the nodes until the destination
+	* - RECONSTRUCTION : the construction of the path from the predecessors
+	*/
+	enum class Phase : uint8_t {
+		INITIALISATION,
+		SEARCH,
+		RECONSTRUCTION,
+	};
+
+	/*
+	* The work done by a query.
+	* - settled : the nodes popped from the queue and settled
+	* - relaxations : the edges relaxed
+	* - decreases : the relaxations that shortened the distance of a node already discovered
+	* - pushes, pops : the operations on the queue, including the duplicates of the queues without decrease of a distance
+	* - peak : the largest size of the queue
+	* - durations : the wall time of each phase, indexed by Phase
+	*/
+	struct QueryStatistics {
+		uint64_t settled = 0;
+		uint64_t relaxations = 0;
+		uint64_t decreases = 0;
+		uint64_t pushes = 0;
+		uint64_t pops = 0;
+		size_t peak = 0;
+		array<chrono::nanoseconds, 3> durations = {};
+
+		/*
+		* Returns the wall time of a phase.
+		*/
+		inline chrono::nanoseconds duration(Phase phase) const noexcept {
+			return durations[static_cast<size_t>(phase)];
+		}
+	};
+
+	/*
+	* The statistics policy of the searches that do not measure anything, whose calls compile to nothing.
+	*/
+	struct NoStatistics {
+		inline void clear() noexcept {}
+		inline void pushed(size_t) noexcept {}
+		inline void popped() noexcept {}
+		inline void settled() noexcept {}
+		inline void relaxed() noexcept {}
+		inline void decreased() noexcept {}
+		inline void start() noexcept {}
+		inline void stop(Phase) noexcept {}
+	};
+
+	/*
+	* The statistics policy of the searches that fill a QueryStatistics.
+	* The counts, peak and durations add up until clear() is called, which the workspaces and search contexts do on reset().
+	*/
+	struct Statistics {
+		QueryStatistics data;
+		chrono::steady_clock::time_point mark;
+
+		/*
+		* Forgets the work of the previous queries.
+		*/
+		inline void clear() noexcept {
+			data = QueryStatistics();
+		}
+
+		inline void pushed(size_t size) noexcept {
+			++data.pushes;
+			data.peak = max(data.peak, size);
+		}
+
+		inline void popped() noexcept {
+			++data.pops;
+		}
+
+		inline void settled() noexcept {
+			++data.settled;
+		}
+
+		inline void relaxed() noexcept {
+			++data.relaxations;
+		}
+
+		inline void decreased() noexcept {
+			++data.decreases;
+		}
+
+		/*
+		* Starts the timing of a phase.
+		*/
+		inline void start() noexcept {
+			mark = chrono::steady_clock::now();
+		}
+
+		/*
+		* Adds the time elapsed since the start of a phase to its duration, and starts the next phase.
+		*/
+		inline void stop(Phase phase) noexcept {
+			const auto now = chrono::steady_clock::now();
+
+			data.durations[static_cast<size_t>(phase)] += chrono::duration_cast<chrono::nanoseconds>(now - mark);
+			mark = now;
+		}
+	};
+
+	template <typename W>
+	class Path;
+
+	/*
+	* The state of a search in one direction, that a caller can keep to run several searches without allocating again.
+	* A node is discovered once its distance is finite, and settled once it has been popped from the queue.
+	* After a search, distances and preds hold the shortest path tree of the settled nodes; preds[v] is n when v has no predecessor.
+	*
+	* @param	W	the type of the distances
+	* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+	* @param	Stats	the statistics policy, NoStatistics or Statistics
+	*/
+	template <typename W, template <typename> class Queue = FibonacciHeap, class Stats = NoStatistics>
+	struct Workspace {
+		Queue<W> queue;
+		vector<W> distances;
+		vector<vertex_id> preds;
+		vector<bool> settled;
+		Stats stats;
+
+		/*
+		* Prepares a new search, reusing the memory of the previous one and clearing its statistics.
+		*
+		* @param	n	the number of nodes
+		* @param	src	the identifier of the source node
+		*/
+		void reset(size_t n, vertex_id src) {
+			stats.clear();
+			queue.reset(n);
+			distances.assign(n, numeric_limits<W>::max());
+			preds.assign(n, static_cast<vertex_id>(n));
+			settled.assign(n, false);
+
+			push(src, 0);
+			distances[src] = 0;
+		}
+
+		/*
+		* Pushes a node into the queue, or decreases its distance.
+		*
+		* @param	v	the node
+		* @param	key	the key of v in the queue
+		*/
+		inline void push(vertex_id v, W key) {
+			queue.push(v, key);
+			stats.pushed(queue.size());
+		}
+
+		/*
+		* Pops the items of nodes already settled, that the queues without decrease of a distance leave behind.
+		*
+		* @return	true if there is a node left to settle, or false otherwise
+		*/
+		inline bool prune() {
+			while (!queue.empty() && settled[queue.top().first]) {
+				queue.pop();
+				stats.popped();
+			}
+
+			return !queue.empty();
+		}
+
+		/*
+		* Pops and settles the nearest node, asserting the queue has been pruned.
+		*
+		* @return	the node and its distance
+		*/
+		inline pair<vertex_id, W> settle() {
+			const auto nearest = queue.top();
+
+			queue.pop();
+			settled[nearest.first] = true;
+			stats.popped();
+			stats.settled();
+
+			return nearest;
+		}
+
+		/*
+		* Pushes a node or decreases its distance if alt is shorter.
+		*
+		* @param	pred	the node from which the edge is relaxed
+		* @param	v	the node at the end of the edge
+		* @param	alt	the distance of v through pred
+		*/
+		inline void relax(vertex_id pred, vertex_id v, W alt) {
+			stats.relaxed();
+
+			if (!settled[v] && alt < distances[v]) {
+				if (distances[v] != numeric_limits<W>::max())
+					stats.decreased();
+
+				distances[v] = alt;
+				preds[v] = pred;
+				push(v, alt);
+			}
+		}
+
+		/*
+		* Returns the path from the source to a node settled by the search.
+		*
+		* @param	src	the identifier of the source node
+		* @param	dst	the identifier of the destination node
+		* @return	a path from src to dst
+		*/
+		inline Path<W> path(vertex_id src, vertex_id dst) const {
+			return Path<W>::from_preds(preds, distances, src, dst);
+		}
+	};
+
+	/*
+	* The state of a search in one direction, that a thread keeps to run its queries without allocating once it has grown to the size of the graph.
+	* Unlike a Workspace, whose reset writes every node, the nodes are stamped with the epoch of the search that discovered them,
+	* so that a reset only moves to the next epoch and a query costs in proportion to the nodes it discovers.
+	* The default queue is an array heap, as the node-based heaps of boost allocate at every push.
+	*
+	* @param	W	the type of the distances
+	* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+	* @param	Stats	the statistics policy, NoStatistics or Statistics
+	*/
+	template <typename W, template <typename> class Queue = QuaternaryHeap, class Stats = NoStatistics>
+	class SearchContext {
+		private:
+			/*
+			* The state of a node, only valid if it has been discovered in the current epoch.
+			*/
+			struct Slot {
+				W distance;
+				vertex_id pred;
+				uint32_t discovered = 0;
+				uint32_t settled = 0;
+			};
+
+			vector<Slot> slots;
+			uint32_t epoch = 0;
+			// the number of nodes of the current search, that slots may exceed once a larger graph has been searched
+			size_t n = 0;
+
+		public:
+			Queue<W> queue;
+			Stats stats;
+
+			/*
+			* Prepares a new search, in constant time unless the graph has grown or the epochs wrap around, and clears the statistics of the previous one.
+			*
+			* @param	n	the number of nodes
+			* @param	src	the identifier of the source node
+			*/
+			void reset(size_t n, vertex_id src) {
+				stats.clear();
+				queue.reset(n);
+
+				this->n = n;
+				if (slots.size() < n)
+					slots.resize(n);
+
+				if (++epoch == 0) {
+					for (auto& slot : slots)
+						slot.discovered = slot.settled = 0;
+					epoch = 1;
+				}
+
+				slots[src] = { 0, static_cast<vertex_id>(n), epoch, 0 };
+				push(src, 0);
+			}
+
+			/*
+			* Returns the distance of a node, or numeric_limits<W>::max() if it has not been discovered.
+			*/
+			inline W distance(vertex_id v) const noexcept {
+				return slots[v].discovered == epoch ? slots[v].distance : numeric_limits<W>::max();
+			}
+
+			/*
+			* Returns the predecessor of a node, or the number of nodes if it has none.
+			*/
+			inline vertex_id pred(vertex_id v) const noexcept {
+				return slots[v].discovered == epoch ? slots[v].pred : static_cast<vertex_id>(n);
+			}
+
+			/*
+			* Checks if a node has been settled.
+			*/
+			inline bool is_settled(vertex_id v) const noexcept {
+				return slots[v].settled == epoch;
+			}
+
+			/*
+			* Pushes a node into the queue, or decreases its distance.
+			*
+			* @param	v	the node
+			* @param	key	the key of v in the queue
+			*/
+			inline void push(vertex_id v, W key) {
+				queue.push(v, key);
+				stats.pushed(queue.size());
+			}
+
+			/*
+			* Pops the items of nodes already settled, that the queues without decrease of a distance leave behind.
+			*
+			* @return	true if there is a node left to settle, or false otherwise
+			*/
+			inline bool prune() {
+				while (!queue.empty() && is_settled(queue.top().first)) {
+					queue.pop();
+					stats.popped();
+				}
+
+				return !queue.empty();
+			}
+
+			/*
+			* Pops and settles the nearest node, asserting the queue has been pruned.
+			*
+			* @return	the node and its distance
+			*/
+			inline pair<vertex_id, W> settle() {
+				const auto nearest = queue.top();
+
+				queue.pop();
+				slots[nearest.first].settled = epoch;
+				stats.popped();
+				stats.settled();
+
+				return nearest;
+			}
+
+			/*
+			* Pushes a node or decreases its distance if alt is shorter.
+			*
+			* @param	pred	the node from which the edge is relaxed
+			* @param	v	the node at the end of the edge
+			* @param	alt	the distance of v through pred
+			*/
+			inline void relax(vertex_id pred, vertex_id v, W alt) {
+				auto& slot = slots[v];
+				stats.relaxed();
+
+				if (slot.discovered != epoch) {
+					slot = { alt, pred, epoch, 0 };
+					push(v, alt);
+				}
+				else if (slot.settled != epoch && alt < slot.distance) {
+					stats.decreased();
+					slot.distance = alt;
+					slot.pred = pred;
+					push(v, alt);
+				}
+			}
+
+			/*
+			* Returns the path from the source to a node settled by the search.
+			*
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @return	a path from src to dst
+			*/
+			Path<W> path(vertex_id src, vertex_id dst) const {
+				// the path is walked twice so that it is allocated once
+				size_t length = 1;
+				for (auto v = dst; v != src; v = slots[v].pred, ++length)
+					if (slots[v].discovered != epoch)
+						throw out_of_range("There is no path between the source and destination");
+
+				auto vertices = vector<vertex_id>(length);
+				auto distances = vector<W>(length);
+				for (auto v = dst; length-- > 0; v = slots[v].pred) {
+					vertices[length] = v;
+					distances[length] = slots[v].distance;
+				}
+
+				return Path<W>(move(vertices), move(distances));
+			}
+	};
+
+	/*
+	* The position of a node, used by the heuristics of heuristics.hpp to direct the searches.
+	* - x, y : planar coordinates, or the longitude and latitude in degrees on the surface of the Earth
+	*/
+	struct Coordinates {
+		double x = 0;
+		double y = 0;
+	};
+
+	/*
+	* The shortest paths from one source to every node.
+	* - distances : the distance of each node, or numeric_limits<W>::max() if it is unreachable
+	* - preds : the predecessor of each node on its shortest path, or the number of nodes if it has none
+	*/
+	template <typename W>
+	struct ShortestPathTree {
+		vector<W> distances;
+		vector<vertex_id> preds;
+	};
+
+	/*
+	* A read-only view over a contiguous array, that may live in a vector or in a mapped file.
+	*/
+	template <typename T>
+	class ArrayView {
+		private:
+			const T* _data = nullptr;
+			size_t _size = 0;
+
+		public:
+			ArrayView() noexcept = default;
+			ArrayView(const T* data, size_t size) noexcept : _data(data), _size(size) {}
+			ArrayView(const vector<T>& v) noexcept : _data(v.data()), _size(v.size()) {}
+
+			inline const T& operator[] (size_t i) const noexcept {
+				return _data[i];
+			}
+
+			inline const T* data() const noexcept {
+				return _data;
+			}
+
+			inline size_t size() const noexcept {
+				return _size;
+			}
+
+			inline bool empty() const noexcept {
+				return _size == 0;
+			}
+
+			inline const T* begin() const noexcept {
+				return _data;
+			}
+
+			inline const T* end() const noexcept {
+				return _data + _size;
+			}
+	};
+
+	/*
+	* A path found by a search, as the identifiers of its nodes, that are only resolved into labels on demand.
+	* - vertices : the nodes, from the source to the destination
+	* - distances : the distance of each node from the source, so that the weight of the edge i is distances[i + 1] - distances[i]
+	*
+	* @param	W	the type of the weights
+	*/
+	template <typename W>
+	class Path {
+		private:
+			vector<vertex_id> _vertices;
+			vector<W> _distances;
+
+		public:
+			Path() noexcept = default;
+
+			/*
+			* Constructor.
+			*
+			* @param	vertices	the nodes, from the source to the destination
+			* @param	distances	the distance of each node from the source
+			*/
+			Path(vector<vertex_id> vertices, vector<W> distances) noexcept : _vertices(move(vertices)), _distances(move(distances)) {
+				assert(("Every node of a path needs a distance", _vertices.size() == _distances.size()));
+			}
+
+			/*
+			* Reconstructs the path to a node from the predecessors and distances of a search.
+			*
+			* @param	preds	the predecessor of each node
+			* @param	distances	the distance of each node
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @return	a path from src to dst
+			*/
+			static Path from_preds(const vector<vertex_id>& preds, const vector<W>& distances, vertex_id src, vertex_id dst) {
+				auto result = Path();
+
+				result._vertices.push_back(dst);
+				while (result._vertices.back() != src)
+					result._vertices.push_back(preds.at(result._vertices.back()));
+				reverse(result._vertices.begin(), result._vertices.end());
+
+				result._distances.reserve(result._vertices.size());
+				for (const auto v : result._vertices)
+					result._distances.push_back(distances[v]);
+
+				return result;
+			}
+
+			inline const vertex_id& operator[] (size_t i) const noexcept {
+				return _vertices[i];
+			}
+
+			inline size_t size() const noexcept {
+				return _vertices.size();
+			}
+
+			inline bool empty() const noexcept {
+				return _vertices.empty();
+			}
+
+			inline const vertex_id* begin() const noexcept {
+				return _vertices.data();
+			}
+
+			inline const vertex_id* end() const noexcept {
+				return _vertices.data() + _vertices.size();
+			}
+
+			inline ArrayView<vertex_id> vertices() const noexcept {
+				return _vertices;
+			}
+
+			inline ArrayView<W> distances() const noexcept {
+				return _distances;
+			}
+
+			/*
+			* Returns the length of the path.
+			*/
+			inline W distance() const noexcept {
+				return _distances.empty() ? W(0) : _distances.back();
+			}
+
+			/*
+			* Returns the weight of an edge of the path.
+			*
+			* @param	i	the index of the edge, from 0 to size() - 2
+			* @return	the weight of the edge between the nodes i and i + 1
+			*/
+			inline W weight(size_t i) const noexcept {
+				return _distances[i + 1] - _distances[i];
+			}
+
+			/*
+			* Resolves the labels of the nodes.
+			*
+			* @param	graph	the graph the path has been found in, or any class providing label(vertex_id)
+			* @return	the label of each node
+			*/
+			template <class G>
+			vector<string> labels(const G& graph) const {
+				auto result = vector<string>();
+
+				result.reserve(_vertices.size());
+				for (const auto v : _vertices)
+					result.emplace_back(graph.label(v));
+
+				return result;
+			}
+
+			/*
+			* Joins the labels of the nodes.
+			*
+			* @param	graph	the graph the path has been found in, or any class providing label(vertex_id)
+			* @param	separator	the separator between two labels
+			* @return	the labels, separated
+			*/
+			template <class G>
+			string to_string(const G& graph, string_view separator = "/") const {
+				auto result = string();
+
+				for (size_t i = 0; i < _vertices.size(); ++i) {
+					if (i != 0)
+						result += separator;
+					result += graph.label(_vertices[i]);
+				}
+
+				return result;
+			}
+
+			inline bool operator==(const Path& other) const noexcept {
+				return _vertices == other._vertices && _distances == other._distances;
+			}
+
+			inline bool operator!=(const Path& other) const noexcept {
+				return !(*this == other);
+			}
+	};
+
+	/*
+	* An immutable graph in compressed sparse row layout, obtained through Graph::freeze(), the loaders of loader.hpp or the snapshots of snapshot.hpp.
+	* The nodes are numbered from 0 to size() - 1 in the order of their labels at construction, and the edges leaving a node are stored contiguously.
+	* - offsets : the edges leaving the node v are in the range [offsets[v], offsets[v + 1])
+	* - targets, weights : the destination and the weight of each edge
+	* - rev_offsets, rev_sources, rev_weights : the same arrays for the incoming edges, only filled in oriented graphs
+	* - label_offsets, label_chars : the label of the node v is in the range [label_offsets[v], label_offsets[v + 1]) of label_chars
+	* - sorted : the identifiers in the lexicographic order of their labels, to look up a label by binary search
+	* The arrays are views over a storage shared between the copies of the graph, which is either owned or mapped from a file.
+	*
+	* @param	W	An integral type for the edge weights, that supports numeric_limits<>::max(), addition and comparison.
+	*/
+	template <typename W = uint_fast32_t, class = enable_if_t<is_integral_v<W>>>
+	class FrozenGraph {
+		public:
+			/*
+			* The arrays of a frozen graph.
+			*/
+			struct Layout {
+				ArrayView<uint64_t> offsets;
+				ArrayView<vertex_id> targets;
+				ArrayView<W> weights;
+				ArrayView<uint64_t> rev_offsets;
+				ArrayView<vertex_id> rev_sources;
+				ArrayView<W> rev_weights;
+				ArrayView<uint64_t> label_offsets;
+				ArrayView<char> label_chars;
+				ArrayView<vertex_id> sorted;
+			};
+		private:
+			/*
+			* The arrays of a frozen graph built in memory.
+			*/
+			struct Arrays {
+				vector<uint64_t> offsets;
+				vector<vertex_id> targets;
+				vector<W> weights;
+				vector<uint64_t> rev_offsets;
+				vector<vertex_id> rev_sources;
+				vector<W> rev_weights;
+				vector<uint64_t> label_offsets;
+				vector<char> label_chars;
+				vector<vertex_id> sorted;
+			};
+
+			ArrayView<uint64_t> offsets;
+			ArrayView<vertex_id> targets;
+			ArrayView<W> weights;
+			ArrayView<uint64_t> rev_offsets;
+			ArrayView<vertex_id> rev_sources;
+			ArrayView<W> rev_weights;
+			ArrayView<uint64_t> label_offsets;
+			ArrayView<char> label_chars;
+			ArrayView<vertex_id> sorted;
+			shared_ptr<const void> storage;
+			Orientation _or;
+
+		public:
+			/*
+			* Constructor.
+			*
+			* @param	_or	the edge orientation of the original graph
+			* @param	labels	the label of each node
+			* @param	offsets	the offset of the first edge of each node, followed by the number of edges
+			* @param	targets	the destination of each edge
+			* @param	weights	the weight of each edge
+			*/
+			FrozenGraph(Orientation _or, const vector<string>& labels, vector<uint64_t> offsets, vector<vertex_id> targets, vector<W> weights) : _or(_or) {
+				assert(("The offsets do not match the labels", offsets.size() == labels.size() + 1));
+				assert(("The weights do not match the targets", targets.size() == weights.size()));
+
+				auto arrays = make_shared<Arrays>();
+				arrays->offsets = move(offsets);
+				arrays->targets = move(targets);
+				arrays->weights = move(weights);
+
+				own(move(arrays), labels);
+			}
+
+			/*
+			* Constructor, that groups a list of edges by source node in one pass.
+			* An edge listed several times keeps its last weight, as with Graph::add_edge(). In an unoriented graph, each edge is listed in one direction only.
+			*
+			* @param	_or	the edge orientation
+			* @param	labels	the label of each node
+			* @param	edges	the source, destination and weight of each edge
+			*/
+			FrozenGraph(Orientation _or, const vector<string>& labels, const vector<tuple<vertex_id, vertex_id, W>>& edges) : _or(_or) {
+				auto arrays = make_shared<Arrays>();
+				auto& offsets = arrays->offsets;
+				auto& targets = arrays->targets;
+				auto& weights = arrays->weights;
+				const size_t n = labels.size();
+
+				// counting sort on the sources, which keeps the edges of a node in the order they are listed
+				offsets.assign(n + 1, 0);
+				for (const auto& [source, target, _] : edges) {
+					assert(("The edge refers to a node that is not in the graph", source < n && target < n));
+
+					++offsets[source + 1];
+					if (_or == Orientation::UNORIENTED)
+						++offsets[target + 1];
+				}
+				for (size_t v = 0; v < n; ++v)
+					offsets[v + 1] += offsets[v];
+
+				auto adjacency = vector<pair<vertex_id, W>>(offsets.back());
+				auto next = vector<uint64_t>(offsets.begin(), offsets.end() - 1);
+				for (const auto& [source, target, weight] : edges) {
+					adjacency[next[source]++] = make_pair(target, weight);
+					if (_or == Orientation::UNORIENTED)
+						adjacency[next[target]++] = make_pair(source, weight);
+				}
+
+				// group the duplicated edges of each node
+				targets.reserve(adjacency.size());
+				weights.reserve(adjacency.size());
+				for (vertex_id v = 0; v < n; ++v) {
+					const auto first = adjacency.begin() + offsets[v], last = adjacency.begin() + offsets[v + 1];
+
+					stable_sort(first, last, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+					offsets[v] = targets.size();
+
+					for (auto it = first; it != last; ++it)
+						if (it + 1 == last || (it + 1)->first != it->first) {
+							targets.push_back(it->first);
+							weights.push_back(it->second);
+						}
+				}
+				offsets.back() = targets.size();
+
+				own(move(arrays), labels);
+			}
+
+			/*
+			* Constructor over arrays that live in an external storage, such as a mapped file, without copying them.
+			*
+			* @param	_or	the edge orientation
+			* @param	layout	the arrays, that must be consistent
+			* @param	storage	the owner of the memory of the arrays, released with the last copy of the graph
+			*/
+			FrozenGraph(Orientation _or, const Layout& layout, shared_ptr<const void> storage)
+				: offsets(layout.offsets), targets(layout.targets), weights(layout.weights),
+				rev_offsets(layout.rev_offsets), rev_sources(layout.rev_sources), rev_weights(layout.rev_weights),
+				label_offsets(layout.label_offsets), label_chars(layout.label_chars), sorted(layout.sorted), storage(move(storage)), _or(_or) {
+				assert(("The offsets do not match the labels", offsets.size() == label_offsets.size() && sorted.size() + 1 == offsets.size()));
+				assert(("The weights do not match the targets", targets.size() == weights.size()));
+				assert(("The incoming edges are missing", _or == Orientation::UNORIENTED || rev_offsets.size() == offsets.size()));
+			}
+
+			/*
+			* Returns the arrays of the graph, that are valid as long as a copy of the graph exists.
+			*/
+			inline Layout get_layout() const noexcept {
+				return { offsets, targets, weights, rev_offsets, rev_sources, rev_weights, label_offsets, label_chars, sorted };
+			}
+
+			/* NODES */
+
+			/*
+			* Returns the number of nodes.
+			*/
+			inline size_t size() const noexcept {
+				return sorted.size();
+			}
+
+			/*
+			* Check if the graph is empty.
+			*
+			* @return	true if there is no node, or false otherwise
+			*/
+			inline bool empty() const noexcept {
+				return sorted.empty();
+			}
+
+			/*
+			* Check if a node exists.
+			*
+			* @param	label	the label
+			* @return	true if the node exists, or false otherwise
+			*/
+			inline bool contains(string_view label) const noexcept {
+				return lookup(label) != size();
+			}
+
+			/*
+			* Returns the identifier of a node, with a binary search on the labels.
+			*
+			* @param	label	the label, that must exist
+			* @return	the identifier
+			*/
+			inline vertex_id id(string_view label) const {
+				if (const auto v = lookup(label); v != size())
+					return v;
+				else
+					throw out_of_range("The node is not in the graph");
+			}
+
+			/*
+			* Returns the label of a node.
+			*
+			* @param	v	the identifier, that must exist
+			* @return	the label
+			*/
+			inline string_view label(vertex_id v) const {
+				if (v >= size())
+					throw out_of_range("The node is not in the graph");
+
+				return string_view(label_chars.data() + label_offsets[v], label_offsets[v + 1] - label_offsets[v]);
+			}
+
+			/* EDGES */
+
+			/*
+			* Returns the orientation of the original graph.
+			*/
+			inline Orientation get_orientation() const noexcept {
+				return _or;
+			}
+
+			/*
+			* Returns the number of edges, counting both directions of an unoriented edge.
+			*/
+			inline size_t edge_count() const noexcept {
+				return targets.size();
+			}
+
+			/* DIJKSTRA'S ALGORITHM */
+
+			/*
+			* Finds the shortest path between two nodes, asserting it exists.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	mode	the initialisation of the heap
+			* @return	a path that starts with src and ends with dst
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			Path<W> find(string_view src, string_view dst, Insertion mode = Insertion::EAGER) const {
+				assertions(src, dst);
+
+				const auto search = find<Queue>(id(src), id(dst), mode);
+
+				return Path<W>::from_preds(search.preds, search.distances, id(src), id(dst));
+			}
+
+			/*
+			* Finds the shortest path between two nodes in a search context, asserting it exists.
+			* Once the context has grown to the size of the graph, a query allocates nothing but the path it returns.
+			*
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	context	the search context, that must not be shared by concurrent queries
+			* @param	mode	the initialisation of the heap, lazy by default as an eager one pushes every node
+			* @return	a path that starts with src and ends with dst
+			*/
+			template <template <typename> class Queue, class Stats>
+			Path<W> find(string_view src, string_view dst, SearchContext<W, Queue, Stats>& context, Insertion mode = Insertion::LAZY) const {
+				assertions(src, dst);
+
+				search(id(src), id(dst), mode, context);
+
+				return context.path(id(src), id(dst));
+			}
+
+			/*
+			* Finds the shortest path between two nodes, asserting it exists, with two lazy searches: one forward from src and one backward from dst.
+			* The search stops as soon as the sum of the smallest distances in both heaps exceeds the best path seen where the two searches meet,
+			* so that a local query only settles the nodes around src and dst.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @return	a path that starts with src and ends with dst
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			Path<W> find_bidirectional(string_view src, string_view dst) const {
+				assertions(src, dst);
+
+				auto forward = Workspace<W, Queue>();
+				auto backward = Workspace<W, Queue>();
+				forward.reset(size(), id(src));
+				backward.reset(size(), id(dst));
+				auto best = numeric_limits<W>::max();
+				auto meeting = static_cast<vertex_id>(size());
+
+				while (forward.prune() && backward.prune()) {
+					if (best != numeric_limits<W>::max() && forward.queue.top().second + backward.queue.top().second >= best)
+						break;
+
+					// expand the side with the smallest frontier
+					const bool is_forward = forward.queue.size() <= backward.queue.size();
+					auto& search = is_forward ? forward : backward;
+					const auto& other = is_forward ? backward : forward;
+					const auto [_offsets, _targets, _weights] = is_forward ? outgoing() : incoming();
+					auto [nearest, distance] = search.settle();
+
+					for (size_t e = _offsets[nearest]; e < _offsets[nearest + 1]; ++e) {
+						vertex_id neighbor = _targets[e];
+						W alt = distance + _weights[e];
+
+						search.relax(nearest, neighbor, alt);
+
+						if (other.distances[neighbor] != numeric_limits<W>::max() && alt + other.distances[neighbor] < best) {
+							best = alt + other.distances[neighbor];
+							meeting = neighbor;
+						}
+					}
+				}
+
+				if (meeting == size())
+					throw out_of_range("There is no path between the source and destination");
+
+				vector<vertex_id> _path = { meeting };
+				while (_path.back() != id(src))
+					_path.push_back(forward.preds[_path.back()]);
+				reverse(_path.begin(), _path.end());
+				const auto middle = _path.size();
+				while (_path.back() != id(dst))
+					_path.push_back(backward.preds[_path.back()]);
+
+				// the nodes after the meeting one are measured from dst by the backward search
+				const W length = forward.distances[meeting] + backward.distances[meeting];
+				auto distances = vector<W>();
+				distances.reserve(_path.size());
+				for (size_t i = 0; i < _path.size(); ++i)
+					distances.push_back(i < middle ? forward.distances[_path[i]] : length - backward.distances[_path[i]]);
+
+				return Path<W>(move(_path), move(distances));
+			}
+
+			/*
+			* Computes the shortest paths from one node to every node in a single search, into a workspace owned by the caller.
+			* The workspace is reset but keeps its memory, so that repeated calls do not allocate once it has grown to the size of the graph.
+			*
+			* @param	src	the label of the source node
+			* @param	workspace	the workspace, whose distances and preds hold the shortest path tree on return
+			*/
+			template <template <typename> class Queue>
+			void shortest_path_tree(string_view src, Workspace<W, Queue>& workspace) const {
+				assert(("The source node is not in the graph", contains(src)));
+
+				workspace.reset(size(), id(src));
+				expand(workspace, [](vertex_id) { return false; });
+			}
+
+			/*
+			* Computes the shortest paths from one node to every node in a single search.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the label of the source node
+			* @return	the distance and predecessor of every node, indexed by identifier
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			ShortestPathTree<W> shortest_path_tree(string_view src) const {
+				auto workspace = Workspace<W, Queue>();
+				shortest_path_tree(src, workspace);
+
+				return { move(workspace.distances), move(workspace.preds) };
+			}
+
+			/*
+			* Computes the distances from many sources to many targets, with one search per source that stops once every target is settled.
+			* The sources are spread over the workers of a thread pool, each of which reuses its own workspace.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	sources	the labels of the source nodes
+			* @param	targets	the labels of the target nodes
+			* @param	pool	the thread pool
+			* @return	the distances in row-major order, sources.size() rows of targets.size() columns, numeric_limits<W>::max() if a target is unreachable
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			vector<W> distance_matrix(const vector<string_view>& sources, const vector<string_view>& targets, ThreadPool& pool) const {
+				auto _targets = vector<vertex_id>();
+				auto is_target = vector<bool>(size(), false);
+				size_t distinct = 0;
+
+				_targets.reserve(targets.size());
+				for (const auto& target : targets) {
+					assert(("The target node is not in the graph", contains(target)));
+
+					_targets.push_back(id(target));
+					if (!is_target[_targets.back()]) {
+						is_target[_targets.back()] = true;
+						++distinct;
+					}
+				}
+
+				auto matrix = vector<W>(sources.size() * targets.size());
+				auto workspaces = vector<Workspace<W, Queue>>(pool.size());
+
+				pool.parallel_for(sources.size(), [&](size_t i, size_t worker) {
+					assert(("The source node is not in the graph", contains(sources[i])));
+
+					auto& workspace = workspaces[worker];
+					size_t remaining = distinct;
+
+					workspace.reset(size(), id(sources[i]));
+					expand(workspace, [&](vertex_id v) { return is_target[v] && --remaining == 0; });
+
+					for (size_t j = 0; j < _targets.size(); ++j)
+						matrix[i * _targets.size() + j] = workspace.settled[_targets[j]] ? workspace.distances[_targets[j]] : numeric_limits<W>::max();
+				});
+
+				return matrix;
+			}
+
+			/*
+			* Computes the distances from many sources to many targets on a temporary thread pool.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	sources	the labels of the source nodes
+			* @param	targets	the labels of the target nodes
+			* @param	threads	the number of threads
+			* @return	the distances in row-major order, sources.size() rows of targets.size() columns, numeric_limits<W>::max() if a target is unreachable
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			vector<W> distance_matrix(const vector<string_view>& sources, const vector<string_view>& targets, size_t threads = thread::hardware_concurrency()) const {
+				auto pool = ThreadPool(threads);
+
+				return distance_matrix<Queue>(sources, targets, pool);
+			}
+
+		private:
+			/*
+			* Settles the nodes by increasing distance from the source of a workspace or a search context, until the reachable nodes are exhausted or visit returns true.
+			*
+			* @param	workspace	the workspace or search context, that has been reset
+			* @param	visit	called with each node once it is settled, and before its edges are relaxed
+			*/
+			template <class Search, class Visitor>
+			void expand(Search& workspace, Visitor&& visit) const {
+				while (workspace.prune()) {
+					// the remaining nodes are unreachable from the source
+					if (workspace.queue.top().second == numeric_limits<W>::max())
+						break;
+
+					auto [nearest, distance] = workspace.settle();
+
+					if (visit(nearest))
+						break;
+
+					for (size_t e = offsets[nearest]; e < offsets[nearest + 1]; ++e)
+						workspace.relax(nearest, targets[e], distance + weights[e]);
+				}
+			}
+
+			/*
+			* Runs the search between two nodes.
+			*
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	mode	the initialisation of the heap
+			* @return	the search, whose preds and distances hold the path to dst
+			*/
+			template <template <typename> class Queue>
+			Workspace<W, Queue> find(vertex_id src, vertex_id dst, Insertion mode) const {
+				auto workspace = Workspace<W, Queue>();
+				search(src, dst, mode, workspace);
+
+				return workspace;
+			}
+
+			/*
+			* Runs the search between two nodes in a workspace or a search context.
+			*
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	mode	the initialisation of the heap
+			* @param	workspace	the workspace or search context
+			*/
+			template <class Search>
+			void search(vertex_id src, vertex_id dst, Insertion mode, Search& workspace) const {
+				workspace.reset(size(), src);
+
+				if (mode == Insertion::EAGER)
+					for (vertex_id v = 0; v < size(); ++v)
+						if (v != src)
+							workspace.push(v, numeric_limits<W>::max());
+
+				expand(workspace, [dst](vertex_id v) { return v == dst; });
+			}
+
+			/*
+			* Returns the arrays describing the outgoing edges.
+			*/
+			inline tuple<ArrayView<uint64_t>, ArrayView<vertex_id>, ArrayView<W>> outgoing() const noexcept {
+				return make_tuple(offsets, targets, weights);
+			}
+
+			/*
+			* Returns the arrays describing the incoming edges, which are the outgoing ones in an unoriented graph.
+			*/
+			inline tuple<ArrayView<uint64_t>, ArrayView<vertex_id>, ArrayView<W>> incoming() const noexcept {
+				if (_or == Orientation::ORIENTED)
+					return make_tuple(rev_offsets, rev_sources, rev_weights);
+				else
+					return outgoing();
+			}
+
+			/*
+			* Looks up a label with a binary search.
+			*
+			* @param	label	the label
+			* @return	the identifier of the node, or size() if it does not exist
+			*/
+			vertex_id lookup(string_view label) const noexcept {
+				const auto it = lower_bound(sorted.begin(), sorted.end(), label, [this](vertex_id v, string_view _label) {
+					return string_view(label_chars.data() + label_offsets[v], label_offsets[v + 1] - label_offsets[v]) < _label;
+				});
+
+				if (it != sorted.end() && string_view(label_chars.data() + label_offsets[*it], label_offsets[*it + 1] - label_offsets[*it]) == label)
+					return *it;
+				else
+					return static_cast<vertex_id>(size());
+			}
+
+			/*
+			* Takes the ownership of arrays built in memory, after filling the dictionary of the labels and the incoming edges in an oriented graph.
+			*
+			* @param	arrays	the arrays, whose outgoing edges are filled
+			* @param	labels	the label of each node
+			*/
+			void own(shared_ptr<Arrays> arrays, const vector<string>& labels) {
+				arrays->label_offsets.reserve(labels.size() + 1);
+				arrays->label_offsets.push_back(0);
+				for (const auto& label : labels) {
+					arrays->label_chars.insert(arrays->label_chars.end(), label.begin(), label.end());
+					arrays->label_offsets.push_back(arrays->label_chars.size());
+				}
+
+				arrays->sorted.resize(labels.size());
+				iota(arrays->sorted.begin(), arrays->sorted.end(), vertex_id(0));
+				if (!is_sorted(labels.begin(), labels.end()))
+					sort(arrays->sorted.begin(), arrays->sorted.end(), [&labels](vertex_id lhs, vertex_id rhs) { return labels[lhs] < labels[rhs]; });
+				assert(("The labels are not unique", adjacent_find(arrays->sorted.begin(), arrays->sorted.end(), [&labels](vertex_id lhs, vertex_id rhs) { return labels[lhs] == labels[rhs]; }) == arrays->sorted.end()));
+
+				if (_or == Orientation::ORIENTED)
+					transpose(*arrays, labels.size());
+
+				offsets = arrays->offsets;
+				targets = arrays->targets;
+				weights = arrays->weights;
+				rev_offsets = arrays->rev_offsets;
+				rev_sources = arrays->rev_sources;
+				rev_weights = arrays->rev_weights;
+				label_offsets = arrays->label_offsets;
+				label_chars = arrays->label_chars;
+				sorted = arrays->sorted;
+				storage = move(arrays);
+			}
+
+			/*
+			* Builds the incoming edges arrays from the outgoing ones, with a counting sort on the targets.
+			*
+			* @param	arrays	the arrays
+			* @param	n	the number of nodes
+			*/
+			static void transpose(Arrays& arrays, size_t n) {
+				arrays.rev_offsets.assign(n + 1, 0);
+				arrays.rev_sources.resize(arrays.targets.size());
+				arrays.rev_weights.resize(arrays.weights.size());
+
+				for (const auto v : arrays.targets)
+					++arrays.rev_offsets[v + 1];
+				for (size_t v = 0; v < n; ++v)
+					arrays.rev_offsets[v + 1] += arrays.rev_offsets[v];
+
+				auto next = vector<uint64_t>(arrays.rev_offsets.begin(), arrays.rev_offsets.end() - 1);
+				for (vertex_id v = 0; v < n; ++v)
+					for (size_t e = arrays.offsets[v]; e < arrays.offsets[v + 1]; ++e) {
+						arrays.rev_sources[next[arrays.targets[e]]] = v;
+						arrays.rev_weights[next[arrays.targets[e]]++] = arrays.weights[e];
+					}
+			}
+
+			/*
+			* Performs quick assertions to ensure the search for the shortest path can start (but not if it will succeed).
+			*
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			*/
+			inline void assertions([[maybe_unused]] string_view src, [[maybe_unused]] string_view dst) const {
+				assert(("The graph is empty", !empty()));
+				assert(("The source node is not in the graph", contains(src)));
+				assert(("The destination node is not in the graph", contains(dst)));
+				assert(("The source and destination are the same", dst != src));
+			}
+	};
+
 	/*
 	* A simple Graph class.
 	* - Orientation : The graph is either oriented or not.
 	*	In reality all egdes are oriented, but the add_edge() and add_node() methods uses oriented edges to simulate unorientation.
 	* - Weights : The graph can contain weighted edges, unweighted edges, or a mix of both, depending on the arguments passed to add_edge() and add_node().
 	*	Under the hood all 
+	* - Identifiers : Each label is interned once into a dense vertex_id, that indexes the nodes and keys the edges.
+	*	Every method has an overload taking identifiers, that skips the lookup of the labels. The identifier of a removed node is never reused.
+	* - Predecessors : The edges of an unoriented graph go both ways, so that a node knows its predecessors as its neighbors.
+	*	An oriented graph can keep the incoming edges of each node as well, with set_reverse_index(), for removals in the degree of the node and backward searches.
 	* 
 	* @param	W	An integral type for the edge weights, that supports numeric_limits<>::max(), addition and comparison.
 	*/
@@ -47,233 +1242,1126 @@ namespace dijkstra {
 	class Graph {
 		public:
 			/*
-			* A simple Node class, essentially a wrapper around edges.
+			* A simple Node class, essentially a wrapper around edges and a position.
+			*/
+			struct Node {
+				pmr::map<vertex_id, W> neighbors = {};
+				Coordinates coordinates = {};
+			};
+		private:
+			pmr::memory_resource* resource;
+			vector<Node> nodes;
+			// a deque, so that the labels never move and the keys of ids can view them
+			deque<string> labels;
+			vector<bool> removed;
+			unordered_map<string_view, vertex_id> ids;
+			// the incoming edges of each node of an oriented graph, by predecessor, if reverse_indexed
+			vector<pmr::map<vertex_id, W>> incoming;
+			bool reverse_indexed;
+			Orientation _or;
+			uint64_t version;
+
+		public:
+			/*
+			* Constructor.
+			* The edges are allocated from a memory resource, so that a whole graph can be built into a few large blocks,
+			* such as the ones of a pmr::monotonic_buffer_resource, or recycled by a pmr::unsynchronized_pool_resource. The resource must outlive the graph.
+			* 
+			* @param	_or	the edge orientation
+			* @param	resource	the memory resource of the edges
+			*/
+			Graph(Orientation _or = Orientation::UNORIENTED, pmr::memory_resource* resource = pmr::get_default_resource()) noexcept
+				: resource(resource), nodes({}), labels({}), removed({}), ids({}), incoming({}), reverse_indexed(false), _or(_or), version(0) {}
+
+			/*
+			* Copy constructor, whose copy allocates from the memory resource of the original.
+			*/
+			Graph(const Graph& other) : resource(other.resource), labels(other.labels), removed(other.removed), reverse_indexed(other.reverse_indexed), _or(other._or), version(other.version) {
+				nodes.reserve(other.nodes.size());
+				for (const auto& node : other.nodes)
+					nodes.push_back({ pmr::map<vertex_id, W>(node.neighbors, resource), node.coordinates });
+				incoming.reserve(other.incoming.size());
+				for (const auto& edges : other.incoming)
+					incoming.emplace_back(edges, resource);
+
+				// the keys must view the labels of the copy
+				ids.reserve(other.ids.size());
+				for (vertex_id v = 0; v < labels.size(); ++v)
+					if (!removed[v])
+						ids.emplace(labels[v], v);
+			}
+
+			Graph(Graph&&) noexcept = default;
+
+			/*
+			* Copy assignment, after which the graph allocates from the memory resource of the original.
+			*/
+			Graph& operator=(const Graph& other) {
+				return *this = Graph(other);
+			}
+
+			/*
+			* Move assignment.
+			* The version becomes greater than both the former one and the one of the other graph, so that what was keyed by the former versions, such as a PathCache, sees a change.
+			*/
+			Graph& operator=(Graph&& other) noexcept {
+				const auto stamp = max(version, other.version) + 1;
+
+				resource = other.resource;
+				nodes = move(other.nodes);
+				labels = move(other.labels);
+				removed = move(other.removed);
+				ids = move(other.ids);
+				incoming = move(other.incoming);
+				reverse_indexed = other.reverse_indexed;
+				_or = other._or;
+				version = stamp;
+
+				return *this;
+			}
+
+			/*
+			* Returns the memory resource of the edges.
+			*/
+			inline pmr::memory_resource* get_resource() const noexcept {
+				return resource;
+			}
+
+			/*
+			* Returns the version of the graph, that every change of its nodes or edges increments.
+			*/
+			inline uint64_t get_version() const noexcept {
+				return version;
+			}
+
+			/* NODES */
+
+			/*
+			* Returns the underlying node container.
+			* 
+			* @return	a vector of nodes indexed by identifier, where the removed nodes have no edge
+			*/
+			inline const vector<Node>& get_nodes() const noexcept {
+				return nodes;
+			}
+
+			/*
+			* Returns the number of nodes.
+			*/
+			inline size_t size() const noexcept {
+				return ids.size();
+			}
+
+			/*
+			* Check if a node exists.
+			*
+			* @param	label	the label
+			* @return	true if the node exists, or false otherwise
+			*/
+			inline bool contains(string_view label) const noexcept {
+				return ids.find(label) != ids.end();
+			}
+
+			/*
+			* Check if a node exists.
+			*
+			* @param	v	the identifier
+			* @return	true if the node exists, or false otherwise
+			*/
+			inline bool contains(vertex_id v) const noexcept {
+				return v < nodes.size() && !removed[v];
+			}
+
+			/*
+			* Check if the graph is empty.
+			*
+			* @return	true if the node container is empty, or false otherwise
+			*/
+			inline bool empty() const noexcept {
+				return ids.empty();
+			}
+
+			/*
+			* Returns the identifier of a node.
+			*
+			* @param	label	the label, that must exist
+			* @return	the identifier
+			*/
+			inline vertex_id id(string_view label) const {
+				return ids.at(label);
+			}
+
+			/*
+			* Returns the label of a node.
+			*
+			* @param	v	the identifier, that must exist
+			* @return	the label
+			*/
+			inline const string& label(vertex_id v) const {
+				return labels.at(v);
+			}
+
+			/*
+			* Reserves the room of a number of nodes, so that building the graph does not reallocate its node containers.
+			* The edges are allocated one by one from the memory resource of the graph, which a pmr::monotonic_buffer_resource can preallocate.
+			*
+			* @param	count	the number of nodes
+			* @return	this
+			*/
+			Graph& reserve(size_t count) {
+				nodes.reserve(count);
+				removed.reserve(count);
+				ids.reserve(count);
+				if (reverse_indexed)
+					incoming.reserve(count);
+
+				return *this;
+			}
+
+			/*
+			* Adds a node. Idempotent.
+			* The label is only copied if the node is new, so that looking up an existing node does not allocate.
+			* 
+			* @param	label	the label
+			* @return	the identifier of the node
+			*/
+			vertex_id add_node(string_view label) {
+				if (auto it = ids.find(label); it != ids.end())
+					return it->second;
+
+				labels.emplace_back(label);
+
+				return insert_node();
+			}
+
+			/*
+			* Adds a node. Idempotent.
+			* The label is moved into the graph if the node is new.
+			* 
+			* @param	label	the label
+			* @return	the identifier of the node
+			*/
+			vertex_id add_node(string&& label) {
+				if (auto it = ids.find(label); it != ids.end())
+					return it->second;
+
+				labels.push_back(move(label));
+
+				return insert_node();
+			}
+
+			/*
+			* Adds a node. Idempotent.
+			* 
+			* @param	label	the label
+			* @return	the identifier of the node
+			*/
+			inline vertex_id add_node(const char* label) {
+				return add_node(string_view(label));
+			}
+
+			/*
+			* Adds a node and the weighted egdes between neighbors. All non-existing neighbors will be created on the fly.
+			*
+			* @param	label	the label
+			* @param	neighbors	the edges
+			* 
+			* @return	this
+			*/
+			Graph& add_node(string label, const map<string, W>& neighbors) {
+				const auto v = add_node(move(label));
+
+				for (const auto& [neighbor, weight] : neighbors)
+					emplace_edge(v, add_node(neighbor), weight);
+
+				return *this;
+			}
+
+			/*
+			* Adds a node and the weighted egdes between neighbors. All non-existing neighbors will be created on the fly. All edge weights are defaulted to 0 (can emulate unweighted graphs).
+			*
+			* @param	label	the label
+			* @param	neighbors	the edges
+			* 
+			* @return	this
+			*/
+			Graph& add_node(string label, const set<string>& neighbors) {
+				const auto v = add_node(move(label));
+
+				for (const auto& neighbor : neighbors)
+					emplace_edge(v, add_node(neighbor), W(0));
+
+				return *this;
+			}
+
+			/*
+			* Sets the position of a node.
+			*
+			* @param	label	the label, that must exist
+			* @param	coordinates	the coordinates
+			*/
+			inline void set_coordinates(string_view label, Coordinates coordinates) {
+				set_coordinates(id(label), coordinates);
+			}
+
+			/*
+			* Sets the position of a node.
+			*
+			* @param	v	the identifier, that must exist
+			* @param	coordinates	the coordinates
+			*/
+			inline void set_coordinates(vertex_id v, Coordinates coordinates) {
+				assert(("The node is not in the graph", contains(v)));
+
+				nodes[v].coordinates = coordinates;
+			}
+
+			/*
+			* Returns the position of a node, which is (0, 0) unless it has been set.
+			*
+			* @param	v	the identifier, that must exist
+			* @return	the coordinates
+			*/
+			inline const Coordinates& get_coordinates(vertex_id v) const {
+				return nodes.at(v).coordinates;
+			}
+
+			/*
+			* Removes a node and any edge pointing to it.
+			*
+			* @param	label	the label
+			*/
+			void remove_node(string_view label) {
+				if (auto it = ids.find(label); it != ids.end())
+					remove_node(it->second);
+			}
+
+			/*
+			* Removes a node and any edge pointing to it.
+			*
+			* @param	v	the identifier
+			*/
+			void remove_node(vertex_id v) {
+				if (!contains(v))
+					return;
+
+				if (has_reverse_index())
+					detach(v);
+				else
+					for (auto& node : nodes)
+						node.neighbors.erase(v);
+
+				release(v);
+				++version;
+			}
+
+			/*
+			* Removes a batch of nodes and any edge pointing to them, skipping the ones that do not exist.
+			* Only the edges of the removed nodes are visited if their predecessors are known, and otherwise the graph is swept once for the whole batch.
+			*
+			* @param	batch	the identifiers
+			*/
+			void remove_nodes(const vector<vertex_id>& batch) {
+				size_t count = 0;
+
+				for (const auto v : batch)
+					if (contains(v)) {
+						if (has_reverse_index())
+							detach(v);
+						release(v);
+						++count;
+					}
+
+				if (count == 0)
+					return;
+
+				if (!has_reverse_index())
+					for (vertex_id u = 0; u < nodes.size(); ++u)
+						if (!removed[u])
+							for (auto it = nodes[u].neighbors.begin(); it != nodes[u].neighbors.end();)
+								it = removed[it->first] ? nodes[u].neighbors.erase(it) : next(it);
+
+				++version;
+			}
+
+			/* EDGES */
+
+			/*
+			* Returns the orientation.
+			*/
+			inline Orientation get_orientation() const noexcept {
+				return _or;
+			}
+
+			/*
+			* Keeps or drops the incoming edges of each node of an oriented graph, that are then updated along with the edges.
+			* Building the index takes a pass over the edges, and it doubles their memory footprint. An unoriented graph needs none.
+			*
+			* @param	enabled	true to keep the incoming edges, or false to free them
+			*/
+			void set_reverse_index(bool enabled) {
+				if (_or == Orientation::UNORIENTED || enabled == reverse_indexed)
+					return;
+
+				reverse_indexed = enabled;
+				incoming.clear();
+				incoming.shrink_to_fit();
+
+				if (enabled) {
+					incoming.reserve(nodes.size());
+					for (vertex_id v = 0; v < nodes.size(); ++v)
+						incoming.emplace_back(resource);
+					for (vertex_id v = 0; v < nodes.size(); ++v)
+						for (const auto& [neighbor, weight] : nodes[v].neighbors)
+							incoming[neighbor].emplace_hint(incoming[neighbor].end(), v, weight);
+				}
+			}
+
+			/*
+			* Checks if the predecessors of the nodes are known, which they always are in an unoriented graph.
+			*/
+			inline bool has_reverse_index() const noexcept {
+				return _or == Orientation::UNORIENTED || reverse_indexed;
+			}
+
+			/*
+			* Returns the incoming edges of a node.
+			*
+			* @param	v	the identifier, that must exist
+			* @return	the weight of the edge from each predecessor, which are the neighbors in an unoriented graph
+			*/
+			inline const pmr::map<vertex_id, W>& predecessors(vertex_id v) const {
+				assert(("The graph has no reverse index", has_reverse_index()));
+				assert(("The node is not in the graph", contains(v)));
+
+				return _or == Orientation::UNORIENTED ? nodes[v].neighbors : incoming[v];
+			}
+
+			/*
+			* Adds an edge, whose weight is optional and defaults to 0.
+			* If the graph is oriented, the order in wich the node labels are specified is significant; non-existing nodes will be created on the fly.
+			*
+			* @param	label0	the label of the first node
+			* @param	label1	the label of the second node
+			* @note	Self-edges are authorised
+			*/
+			void add_edge(string_view label0, string_view label1, W weight = W(0)) {
+				add_edge(add_node(label0), add_node(label1), weight);
+			}
+
+			/*
+			* Adds an edge between two existing nodes, whose weight is optional and defaults to 0.
+			*
+			* @param	v0	the identifier of the first node
+			* @param	v1	the identifier of the second node
+			* @note	Self-edges are authorised
+			*/
+			void add_edge(vertex_id v0, vertex_id v1, W weight = W(0)) {
+				assert(("The first node is not in the graph", contains(v0)));
+				assert(("The second node is not in the graph", contains(v1)));
+
+				nodes[v0].neighbors[v1] = weight;
+
+				if (_or == Orientation::UNORIENTED)
+					nodes[v1].neighbors[v0] = weight;
+				else if (reverse_indexed)
+					incoming[v1][v0] = weight;
+
+				++version;
+			}
+
+			/*
+			* Adds an edge or changes its weight, for chained construction; non-existing nodes will be created on the fly.
+			*
+			* @param	label0	the label of the first node
+			* @param	label1	the label of the second node
+			* @param	weight	the weight
+			* @return	this
+			*/
+			inline Graph& emplace_edge(string_view label0, string_view label1, W weight = W(0)) {
+				return emplace_edge(add_node(label0), add_node(label1), weight);
+			}
+
+			/*
+			* Adds an edge between two existing nodes or changes its weight, for chained construction.
+			* Each end is first tried after the last neighbor of the other, so that the edges given in increasing order of their targets are inserted in amortized constant time.
+			*
+			* @param	v0	the identifier of the first node
+			* @param	v1	the identifier of the second node
+			* @param	weight	the weight
+			* @return	this
+			*/
+			Graph& emplace_edge(vertex_id v0, vertex_id v1, W weight = W(0)) {
+				assert(("The first node is not in the graph", contains(v0)));
+				assert(("The second node is not in the graph", contains(v1)));
+
+				nodes[v0].neighbors.insert_or_assign(nodes[v0].neighbors.end(), v1, weight);
+
+				if (_or == Orientation::UNORIENTED)
+					nodes[v1].neighbors.insert_or_assign(nodes[v1].neighbors.end(), v0, weight);
+				else if (reverse_indexed)
+					incoming[v1].insert_or_assign(incoming[v1].end(), v0, weight);
+
+				++version;
+
+				return *this;
+			}
+
+			/*
+			* Sets the weights of a batch of edges, adding the edges that do not exist yet, in the order of the batch.
+			*
+			* @param	updates	the first node, second node and new weight of each edge, by identifier
+			*/
+			void update_weights(const vector<tuple<vertex_id, vertex_id, W>>& updates) {
+				for (const auto& [v0, v1, weight] : updates)
+					add_edge(v0, v1, weight);
+			}
+
+			/*
+			* Removes an edge.
+			*
+			* @param	label0	the label of the first node
+			* @param	label1	the label of the second node
+			* @return	true if the edge exists and has been removed, or false otherwise
 			*/
-			struct Node {
-				map<string, W> neighbors = {};
-			};
+			bool remove_edge(string_view label0, string_view label1) {
+				return contains(label0) && contains(label1) && remove_edge(id(label0), id(label1));
+			}
 
 			/*
-			* The comparator for the items in the fibonacci heap.
+			* Removes an edge.
+			*
+			* @param	v0	the identifier of the first node
+			* @param	v1	the identifier of the second node
+			* @return	true if the edge exists and has been removed, or false otherwise
 			*/
-			struct comparator {
-				inline bool operator() (const pair<string, W>& lhs, const pair<string, W>& rhs) const {
-					return get<1>(lhs) > get<1>(rhs);
+			bool remove_edge(vertex_id v0, vertex_id v1) {
+				if (has_neighbor(v0, v1)) {
+					nodes[v0].neighbors.erase(v1);
+
+					if (_or == Orientation::UNORIENTED)
+						nodes[v1].neighbors.erase(v0);
+					else if (reverse_indexed)
+						incoming[v1].erase(v0);
+
+					++version;
+					return true;
 				}
-			};
-		private:
-			map<string, Node> nodes;
-			Orientation _or;
+				else
+					return false;
+			}
 
-		public:
 			/*
-			* Constructor.
-			* 
-			* @param	_or	the edge orientation
+			* Checks if two nodes are neighbors
+			*
+			* @param	label0	the label of the first node
+			* @param	label1	the label of the second node
+			* @return	true if the two nodes exist and an edge between the nodes exist, or false otherwise
 			*/
-			Graph(Orientation _or = Orientation::UNORIENTED) noexcept : nodes({}), _or(_or) {}
-
-			/* NODES */
+			bool has_neighbor(string_view label0, string_view label1) const {
+				return contains(label0) && contains(label1) && has_neighbor(id(label0), id(label1));
+			}
 
 			/*
-			* Returns the underlying node container.
-			* 
-			* @return	a map of strings to nodes
+			* Checks if two nodes are neighbors
+			*
+			* @param	v0	the identifier of the first node
+			* @param	v1	the identifier of the second node
+			* @return	true if the two nodes exist and an edge between the nodes exist, or false otherwise
 			*/
-			inline const map<string, Node>& get_nodes() const noexcept {
-				return nodes;
+			bool has_neighbor(vertex_id v0, vertex_id v1) const {
+				return contains(v0) && contains(v1) && nodes[v0].neighbors.find(v1) != nodes[v0].neighbors.end();
 			}
 
+			/* FREEZING */
+
 			/*
-			* Check if a node exists.
+			* Builds an immutable compressed sparse row copy of the graph, better suited to serve many queries.
+			* The nodes are numbered in the lexicographic order of their labels.
 			*
-			* @param	label	the label
-			* @return	true if the node exists, or false otherwise
+			* @return	the frozen graph
 			*/
-			inline bool contains(string label) const noexcept {
-				return nodes.find(label) != nodes.end();
+			FrozenGraph<W> freeze() const {
+				auto order = vector<vertex_id>();
+				auto frozen = vector<vertex_id>(nodes.size());
+				auto labels = vector<string>();
+				auto offsets = vector<uint64_t>();
+				auto targets = vector<vertex_id>();
+				auto weights = vector<W>();
+
+				order.reserve(size());
+				for (vertex_id v = 0; v < nodes.size(); ++v)
+					if (!removed[v])
+						order.push_back(v);
+				sort(order.begin(), order.end(), [this](vertex_id lhs, vertex_id rhs) { return this->labels[lhs] < this->labels[rhs]; });
+
+				labels.reserve(order.size());
+				for (vertex_id v = 0; v < order.size(); ++v) {
+					frozen[order[v]] = v;
+					labels.push_back(this->labels[order[v]]);
+				}
+
+				offsets.reserve(order.size() + 1);
+				offsets.push_back(0);
+				for (const auto v : order) {
+					for (const auto& [neighbor, weight] : nodes[v].neighbors) {
+						targets.push_back(frozen[neighbor]);
+						weights.push_back(weight);
+					}
+					offsets.push_back(targets.size());
+				}
+
+				return FrozenGraph<W>(_or, labels, move(offsets), move(targets), move(weights));
 			}
 
 			/*
-			* Check if the graph is empty.
+			* Returns a copy of the graph where every edge is reversed, with the same identifiers.
+			* An unoriented graph is its own transpose.
 			*
-			* @return	true if the node container is empty, or false otherwise
+			* @return	the transposed graph
 			*/
-			inline bool empty() const noexcept {
-				return nodes.empty();
+			Graph transpose() const {
+				auto result = *this;
+
+				if (_or == Orientation::ORIENTED && reverse_indexed) {
+					for (vertex_id v = 0; v < nodes.size(); ++v)
+						swap(result.nodes[v].neighbors, result.incoming[v]);
+				}
+				else if (_or == Orientation::ORIENTED) {
+					for (auto& node : result.nodes)
+						node.neighbors.clear();
+
+					for (vertex_id v = 0; v < nodes.size(); ++v)
+						for (const auto& [neighbor, weight] : nodes[v].neighbors)
+							result.nodes[neighbor].neighbors[v] = weight;
+				}
+
+				return result;
 			}
 
+			/* DIJKSTRA'S ALGORITHM */
+
 			/*
-			* Adds a node. Idempotent.
-			* 
-			* @param	label	the label
+			* Finds the shortest path between two nodes, asserting it exists.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	mode	the initialisation of the heap
+			* @return	a path that starts with src and ends with dst
+			* @cite	@article{dijkstra1959note, title={A note on two problems in connexion with graphs}, author={Dijkstra, Edsger W and others}, journal={Numerische mathematik}, volume={1}, number={1}, pages={269--271}, year={1959}}
 			*/
-			void add_node(string label) {
-				if (!contains(label))
-					nodes[label] = {};
+			template <template <typename> class Queue = FibonacciHeap>
+			Path<W> find(string_view src, string_view dst, Insertion mode = Insertion::EAGER) const {
+				assertions(src, dst);
+
+				return find<Queue>(id(src), id(dst), mode);
 			}
 
 			/*
-			* Adds a node and the weighted egdes between neighbors. All non-existing neighbors will be created on the fly.
+			* Finds the shortest path between two nodes, asserting it exists.
 			*
-			* @param	label	the label
-			* @param	neighbors	the edges
-			* 
-			* @return	this
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	mode	the initialisation of the heap
+			* @return	a path that starts with src and ends with dst
 			*/
-			Graph add_node(string label, const map<string, W>& neighbors) {
-				add_node(label);
+			template <template <typename> class Queue = FibonacciHeap>
+			Path<W> find(vertex_id src, vertex_id dst, Insertion mode = Insertion::EAGER) const {
+				auto search = Workspace<W, Queue>();
 
-				for (const auto& [neighbor, weight] : neighbors)
-					add_edge(label, neighbor, weight);
+				return query(src, dst, mode, search);
+			}
 
-				if (_or == Orientation::UNORIENTED)
-					for (const auto& [neighbor, weight] : neighbors)
-						add_edge(neighbor, label, weight);
+			/*
+			* Finds the shortest path between two nodes, asserting it exists, and measures the work done by the search.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	mode	the initialisation of the heap
+			* @param	sink	called with the const QueryStatistics& of the query, before the path is returned
+			* @return	a path that starts with src and ends with dst
+			*/
+			template <template <typename> class Queue = FibonacciHeap, class Sink>
+			Path<W> find(string_view src, string_view dst, Insertion mode, Sink&& sink) const {
+				assertions(src, dst);
 
-				return this;
+				return find<Queue>(id(src), id(dst), mode, forward<Sink>(sink));
 			}
 
 			/*
-			* Adds a node and the weighted egdes between neighbors. All non-existing neighbors will be created on the fly. All edge weights are defaulted to 0 (can emulate unweighted graphs).
+			* Finds the shortest path between two nodes, asserting it exists, and measures the work done by the search.
 			*
-			* @param	label	the label
-			* @param	neighbors	the edges
-			* 
-			* @return	this
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	mode	the initialisation of the heap
+			* @param	sink	called with the const QueryStatistics& of the query, before the path is returned
+			* @return	a path that starts with src and ends with dst
 			*/
-			Graph add_node(string label, const set<string>& neighbors) {
-				auto _neighbors = map<string, W>();
+			template <template <typename> class Queue = FibonacciHeap, class Sink>
+			Path<W> find(vertex_id src, vertex_id dst, Insertion mode, Sink&& sink) const {
+				auto search = Workspace<W, Queue, Statistics>();
+				auto result = query(src, dst, mode, search);
 
-				for (const auto& _label : neighbors)
-					_neighbors[_label] = 0;
+				sink(static_cast<const QueryStatistics&>(search.stats.data));
 
-				return add_node(label, neighbors);
+				return result;
 			}
 
 			/*
-			* Removes a node and any edge pointing to it.
+			* Finds the shortest path between two nodes in a search context, asserting it exists.
+			* Once the context has grown to the size of the graph, a query allocates nothing but the path it returns.
 			*
-			* @param	label	the label
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	context	the search context, that must not be shared by concurrent queries
+			* @param	mode	the initialisation of the heap, lazy by default as an eager one pushes every node
+			* @return	a path that starts with src and ends with dst
 			*/
-			void remove_node(string label) {
-				nodes.erase(label);
+			template <template <typename> class Queue, class Stats>
+			Path<W> find(string_view src, string_view dst, SearchContext<W, Queue, Stats>& context, Insertion mode = Insertion::LAZY) const {
+				assertions(src, dst);
 
-				for (auto& [_, node] : nodes)
-					node.neighbors.erase(label);
+				return find(id(src), id(dst), context, mode);
 			}
 
-			/* EDGES */
-
 			/*
-			* Returns the orientation.
+			* Finds the shortest path between two nodes in a search context, asserting it exists.
+			* Once the context has grown to the size of the graph, a query allocates nothing but the path it returns.
+			*
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	context	the search context, that must not be shared by concurrent queries
+			* @param	mode	the initialisation of the heap, lazy by default as an eager one pushes every node
+			* @return	a path that starts with src and ends with dst
 			*/
-			inline Orientation get_orientation() const noexcept {
-				return _or;
+			template <template <typename> class Queue, class Stats>
+			Path<W> find(vertex_id src, vertex_id dst, SearchContext<W, Queue, Stats>& context, Insertion mode = Insertion::LAZY) const {
+				return query(src, dst, mode, context);
 			}
 
 			/*
-			* Adds an edge, whose weight is optional and defaults to 0.
-			* If the graph is oriented, the order in wich the node labels are specified is significant; non-existing nodes will be created on the fly.
+			* Finds the shortest path between two nodes, asserting it exists, and measures the work done by the search.
 			*
-			* @param	label0	the label of the first node
-			* @param	label1	the label of the second node
-			* @note	Self-edges are authorised
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	mode	the initialisation of the heap
+			* @return	a path that starts with src and ends with dst, and the statistics of the query
 			*/
-			void add_edge(string label0, string label1, W weight = W(0)) {
-				add_node(label0);
-				add_node(label1);
+			template <template <typename> class Queue = FibonacciHeap>
+			pair<Path<W>, QueryStatistics> find_with_statistics(vertex_id src, vertex_id dst, Insertion mode = Insertion::EAGER) const {
+				auto statistics = QueryStatistics();
+				auto result = find<Queue>(src, dst, mode, [&statistics](const QueryStatistics& s) { statistics = s; });
 
-				nodes.at(label0).neighbors[label1] = weight;
+				return { move(result), statistics };
+			}
 
-				if (_or == Orientation::UNORIENTED)
-					nodes.at(label1).neighbors[label0] = weight;
+			/*
+			* Finds the shortest paths of a batch of queries, with one search per distinct source that stops once all the destinations of that source are settled.
+			* The sources are spread over the workers of a thread pool, each of which reuses its own workspace.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	queries	the labels of the source and destination nodes of each query
+			* @param	pool	the thread pool
+			* @return	the path of each query in the order of queries, empty if its destination is unreachable
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			vector<Path<W>> find_batch(const vector<pair<string_view, string_view>>& queries, ThreadPool& pool) const {
+				return find_batch<Queue>(identifiers(queries), pool);
 			}
 
 			/*
-			* Removes an edge.
+			* Finds the shortest paths of a batch of queries in the calling thread, or on a temporary thread pool.
 			*
-			* @param	label0	the label of the first node
-			* @param	label1	the label of the second node
-			* @return	true if the edge exists and has been removed, or false otherwise
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	queries	the labels of the source and destination nodes of each query
+			* @param	threads	the number of threads, 1 to run every search in the calling thread without a pool
+			* @return	the path of each query in the order of queries, empty if its destination is unreachable
 			*/
-			bool remove_edge(string label0, string label1) {
-				if (has_neighbor(label0, label1)) {
-					nodes.at(label0).neighbors.erase(label1);
+			template <template <typename> class Queue = FibonacciHeap>
+			vector<Path<W>> find_batch(const vector<pair<string_view, string_view>>& queries, size_t threads = 1) const {
+				return find_batch<Queue>(identifiers(queries), threads);
+			}
 
-					if (_or == Orientation::UNORIENTED && has_neighbor(label1, label0))
-						nodes.at(label1).neighbors.erase(label0);
+			/*
+			* Finds the shortest paths of a batch of queries, with one search per distinct source that stops once all the destinations of that source are settled.
+			* The sources are spread over the workers of a thread pool, each of which reuses its own workspace.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	queries	the identifiers of the source and destination nodes of each query
+			* @param	pool	the thread pool
+			* @return	the path of each query in the order of queries, empty if its destination is unreachable
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			vector<Path<W>> find_batch(const vector<pair<vertex_id, vertex_id>>& queries, ThreadPool& pool) const {
+				return batch<Queue>(queries, pool.size(), [&pool](size_t n, const auto& body) { pool.parallel_for(n, body); });
+			}
 
-					return true;
+			/*
+			* Finds the shortest paths of a batch of queries in the calling thread, or on a temporary thread pool.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	queries	the identifiers of the source and destination nodes of each query
+			* @param	threads	the number of threads, 1 to run every search in the calling thread without a pool
+			* @return	the path of each query in the order of queries, empty if its destination is unreachable
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			vector<Path<W>> find_batch(const vector<pair<vertex_id, vertex_id>>& queries, size_t threads = 1) const {
+				if (threads > 1) {
+					auto pool = ThreadPool(threads);
+
+					return find_batch<Queue>(queries, pool);
 				}
 				else
-					return false;
+					return batch<Queue>(queries, 1, [](size_t n, const auto& body) {
+						for (size_t i = 0; i < n; ++i)
+							body(i, 0);
+					});
 			}
 
 			/*
-			* Checks if two nodes are neighbors
+			* Finds the shortest path between two nodes with the A* algorithm, asserting it exists.
+			* The nodes are pushed into the heap by their distance from src plus an estimate of their distance to dst,
+			* so that the search heads towards dst instead of settling every node closer to src.
 			*
-			* @param	label0	the label of the first node
-			* @param	label1	the label of the second node
-			* @return	true if the two nodes exist and an edge between the nodes exist, or false otherwise
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the label of the source node
+			* @param	dst	the label of the destination node
+			* @param	heuristic	the estimate, among the ones of heuristics.hpp or any functor with the same interface
+			* @return	a path that starts with src and ends with dst
 			*/
-			bool has_neighbor(string label0, string label1) const {
-				return contains(label0) && contains(label1)
-					&& nodes.at(label0).neighbors.find(label1) != nodes.at(label0).neighbors.end();
+			template <template <typename> class Queue = FibonacciHeap, class Heuristic>
+			Path<W> find_astar(string_view src, string_view dst, Heuristic&& heuristic) const {
+				assertions(src, dst);
+
+				return find_astar<Queue>(id(src), id(dst), forward<Heuristic>(heuristic));
 			}
 
-			/* DIJKSTRA'S ALGORITHM */
+			/*
+			* Finds the shortest path between two nodes with the A* algorithm, asserting it exists.
+			* The heuristic must be consistent: heuristic(u, dst) <= weight + heuristic(v, dst) for every edge (u, v) of the given weight, and heuristic(dst, dst) == 0.
+			* It is then a lower bound of the distance to dst, and every node is settled at most once.
+			* The keys of the queue then never decrease, as a RadixHeap requires: an inconsistent heuristic trips its assertion, or misorders it once the assertions are compiled out.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	heuristic	the estimate, called as heuristic(v, dst) and returning a W
+			* @return	a path that starts with src and ends with dst
+			* @cite	@article{hart1968formal, title={A formal basis for the heuristic determination of minimum cost paths}, author={Hart, Peter E and Nilsson, Nils J and Raphael, Bertram}, journal={IEEE transactions on Systems Science and Cybernetics}, volume={4}, number={2}, pages={100--107}, year={1968}}
+			*/
+			template <template <typename> class Queue = FibonacciHeap, class Heuristic>
+			Path<W> find_astar(vertex_id src, vertex_id dst, Heuristic&& heuristic) const {
+				auto search = Workspace<W, Queue>();
+
+				return astar(src, dst, heuristic, search);
+			}
 
 			/*
-			* Finds the shortest path between two nodes, asserting it exists.
+			* Finds the shortest path between two nodes with the A* algorithm, asserting it exists, and measures the work done by the search.
 			*
-			* @param	src	the label of the source node
-			* @param	dst	the label of the destination node
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	heuristic	the estimate, called as heuristic(v, dst) and returning a W
+			* @param	sink	called with the const QueryStatistics& of the query, before the path is returned
+			* @return	a path that starts with src and ends with dst
+			*/
+			template <template <typename> class Queue = FibonacciHeap, class Heuristic, class Sink>
+			Path<W> find_astar(vertex_id src, vertex_id dst, Heuristic&& heuristic, Sink&& sink) const {
+				auto search = Workspace<W, Queue, Statistics>();
+				auto result = astar(src, dst, heuristic, search);
+
+				sink(static_cast<const QueryStatistics&>(search.stats.data));
+
+				return result;
+			}
+
+			/*
+			* Computes the shortest paths from one node to every node in a single search, into a workspace owned by the caller.
+			*
+			* @param	src	the identifier of the source node
+			* @param	workspace	the workspace, whose distances and preds hold the shortest path tree on return, indexed by identifier
+			*/
+			template <template <typename> class Queue>
+			void shortest_path_tree(vertex_id src, Workspace<W, Queue>& workspace) const {
+				assert(("The source node is not in the graph", contains(src)));
+
+				workspace.reset(nodes.size(), src);
+				expand(workspace, [](vertex_id) { return false; });
+			}
+
+			/*
+			* Computes the shortest paths from one node to every node in a single search.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	src	the identifier of the source node
+			* @return	the distance and predecessor of every node, indexed by identifier
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			ShortestPathTree<W> shortest_path_tree(vertex_id src) const {
+				auto workspace = Workspace<W, Queue>();
+				shortest_path_tree(src, workspace);
+
+				return { move(workspace.distances), move(workspace.preds) };
+			}
+
+			/*
+			* Computes the shortest paths from every node to one node in a single backward search along the incoming edges, into a workspace owned by the caller.
+			* An oriented graph must have a reverse index.
+			*
+			* @param	dst	the identifier of the destination node
+			* @param	workspace	the workspace, whose distances hold the distance of every node to dst on return and preds the next node on its path to dst
+			*/
+			template <template <typename> class Queue>
+			void reverse_shortest_path_tree(vertex_id dst, Workspace<W, Queue>& workspace) const {
+				assert(("The destination node is not in the graph", contains(dst)));
+				assert(("The graph has no reverse index", has_reverse_index()));
+
+				workspace.reset(nodes.size(), dst);
+				expand<true>(workspace, [](vertex_id) { return false; });
+			}
+
+			/*
+			* Computes the shortest paths from every node to one node in a single backward search along the incoming edges.
+			* An oriented graph must have a reverse index.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	dst	the identifier of the destination node
+			* @return	the distance of every node to dst and the next node on its path, indexed by identifier
+			*/
+			template <template <typename> class Queue = FibonacciHeap>
+			ShortestPathTree<W> reverse_shortest_path_tree(vertex_id dst) const {
+				auto workspace = Workspace<W, Queue>();
+				reverse_shortest_path_tree(dst, workspace);
+
+				return { move(workspace.distances), move(workspace.preds) };
+			}
+
+		private:
+			/*
+			* Indexes the label just appended to the labels as a new node.
+			*
+			* @return	the identifier of the node
+			*/
+			vertex_id insert_node() {
+				const auto v = static_cast<vertex_id>(nodes.size());
+
+				ids.emplace(labels.back(), v);
+				nodes.push_back({ pmr::map<vertex_id, W>(resource), {} });
+				if (reverse_indexed)
+					incoming.emplace_back(resource);
+				removed.push_back(false);
+				++version;
+
+				return v;
+			}
+
+			/*
+			* Erases the edges that point to a node from its predecessors, and its incoming edges from its successors.
+			*
+			* @param	v	the identifier of the node
+			*/
+			void detach(vertex_id v) {
+				for (const auto& [predecessor, _] : predecessors(v))
+					if (predecessor != v)
+						nodes[predecessor].neighbors.erase(v);
+
+				if (reverse_indexed)
+					for (const auto& [successor, _] : nodes[v].neighbors)
+						if (successor != v)
+							incoming[successor].erase(v);
+			}
+
+			/*
+			* Marks a node as removed and frees its label and its edges, once the other nodes no longer point to it.
+			*
+			* @param	v	the identifier of the node
+			*/
+			void release(vertex_id v) {
+				ids.erase(labels[v]);
+				string().swap(labels[v]);
+				removed[v] = true;
+				nodes[v].neighbors.clear();
+				if (reverse_indexed)
+					incoming[v].clear();
+			}
+
+			/*
+			* Finds the shortest path between two nodes in a workspace or a search context, timing each phase with its statistics policy.
+			*
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	mode	the initialisation of the heap
+			* @param	search	the workspace or search context
 			* @return	a path that starts with src and ends with dst
-			* @cite	@article{dijkstra1959note, title={A note on two problems in connexion with graphs}, author={Dijkstra, Edsger W and others}, journal={Numerische mathematik}, volume={1}, number={1}, pages={269--271}, year={1959}}
 			*/
-			fs::path find(string src, string dst) const {
+			template <class Search>
+			Path<W> query(vertex_id src, vertex_id dst, Insertion mode, Search& search) const {
 				assertions(src, dst);
 
-				auto preds = map<string, string>();
-				auto heap = fibonacci_heap<pair<string, W>, compare<comparator>>();
-				auto handles = map<string, decltype(heap)::handle_type>();
+				search.stats.start();
+				search.reset(nodes.size(), src);
+
+				if (mode == Insertion::EAGER)
+					for (vertex_id v = 0; v < nodes.size(); ++v)
+						if (v != src && !removed[v])
+							search.push(v, numeric_limits<W>::max());
+				search.stats.stop(Phase::INITIALISATION);
+
+				expand(search, [dst](vertex_id v) { return v == dst; });
+				search.stats.stop(Phase::SEARCH);
+
+				auto result = search.path(src, dst);
+				search.stats.stop(Phase::RECONSTRUCTION);
 
-				for (auto& [label, _] : nodes)
-					handles[label] = heap.push(make_pair(label, label == src ? 0 : numeric_limits<W>::max()));
+				return result;
+			}
+
+			/*
+			* Finds the shortest path between two nodes with the A* algorithm in a workspace, timing each phase with its statistics policy.
+			*
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
+			* @param	heuristic	the estimate, called as heuristic(v, dst) and returning a W
+			* @param	search	the workspace
+			* @return	a path that starts with src and ends with dst
+			*/
+			template <class Heuristic, class Search>
+			Path<W> astar(vertex_id src, vertex_id dst, Heuristic& heuristic, Search& search) const {
+				assertions(src, dst);
+
+				search.stats.start();
+				search.reset(nodes.size(), src);
+				search.stats.stop(Phase::INITIALISATION);
 
-				while (!heap.empty()) {
-					auto& [nearest, distance] = heap.top();
+				while (search.prune()) {
+					const auto nearest = search.settle().first;
 
 					if (nearest == dst)
 						break;
 
-					for (auto& [neighbor, weight] : nodes.at(nearest).neighbors)
-						if (handles.find(neighbor) != handles.end())
-							if (W alt = distance + weight; alt < get_distance(heap, neighbor)) {
-								preds[neighbor] = nearest;
-								heap.update(handles.at(neighbor), make_pair(neighbor, alt));
-							}
+					// the queue is keyed by the estimate of the whole path, while the workspace keeps the distances from src
+					for (const auto& [neighbor, weight] : nodes[nearest].neighbors) {
+						const W alt = search.distances[nearest] + weight;
 
-					handles.erase(nearest);
-					heap.pop();
+						search.stats.relaxed();
+						if (!search.settled[neighbor] && alt < search.distances[neighbor]) {
+							if (search.distances[neighbor] != numeric_limits<W>::max())
+								search.stats.decreased();
+
+							search.distances[neighbor] = alt;
+							search.preds[neighbor] = nearest;
+							search.push(neighbor, alt + heuristic(neighbor, dst));
+						}
+					}
 				}
+				search.stats.stop(Phase::SEARCH);
+
+				auto result = search.path(src, dst);
+				search.stats.stop(Phase::RECONSTRUCTION);
 
-				return preds_to_path(preds, src, dst);
+				return result;
 			}
 
-		private:
 			/*
-			* Looks up the distance associated to a label in a heap.
+			* Settles the nodes by increasing distance from the source of a workspace or a search context, until the reachable nodes are exhausted or visit returns true.
 			*
-			* @param	heap	the heap
-			* @param	label	the label
-			* @return	the distance of the node if it exists, or numeric_limits<W>::max() otherwise
+			* @param	backward	true to follow the incoming edges instead of the outgoing ones
+			* @param	workspace	the workspace or search context, that has been reset
+			* @param	visit	called with each node once it is settled, and before its edges are relaxed
+			*/
+			template <bool backward = false, class Search, class Visitor>
+			void expand(Search& workspace, Visitor&& visit) const {
+				while (workspace.prune()) {
+					// the remaining nodes are unreachable from the source
+					if (workspace.queue.top().second == numeric_limits<W>::max())
+						break;
+
+					auto [nearest, distance] = workspace.settle();
+
+					if (visit(nearest))
+						break;
+
+					for (const auto& [neighbor, weight] : backward ? predecessors(nearest) : nodes[nearest].neighbors)
+						workspace.relax(nearest, neighbor, distance + weight);
+				}
+			}
+
+			/*
+			* Finds the shortest paths of a batch of queries, with one search per distinct source that stops once all the destinations of that source are settled.
+			*
+			* @param	Queue	the priority queue policy, among the ones of heaps.hpp
+			* @param	queries	the identifiers of the source and destination nodes of each query
+			* @param	workers	the number of workers, each of which reuses its own workspace
+			* @param	for_each	called as for_each(n, body) to run body(i, worker) for every i in [0, n), with a worker index lower than workers
+			* @return	the path of each query in the order of queries, empty if its destination is unreachable
+			*/
+			template <template <typename> class Queue, class ForEach>
+			vector<Path<W>> batch(const vector<pair<vertex_id, vertex_id>>& queries, size_t workers, ForEach&& for_each) const {
+				// the queries sorted by source then destination, so that the queries of a source are contiguous
+				auto order = vector<size_t>(queries.size());
+				iota(order.begin(), order.end(), size_t(0));
+				sort(order.begin(), order.end(), [&queries](size_t a, size_t b) { return queries[a] < queries[b]; });
+
+				// the first query of each source in order, followed by the number of queries
+				auto groups = vector<size_t>();
+				for (size_t i = 0; i < order.size(); ++i) {
+					assertions(queries[order[i]].first, queries[order[i]].second);
+					if (i == 0 || queries[order[i]].first != queries[order[i - 1]].first)
+						groups.push_back(i);
+				}
+				groups.push_back(order.size());
+
+				auto results = vector<Path<W>>(queries.size());
+				auto workspaces = vector<Workspace<W, Queue>>(workers);
+				// the last source of which each node is a destination, plus one, for each worker
+				auto marks = vector<vector<size_t>>(workers);
+
+				for_each(groups.size() - 1, [&](size_t group, size_t worker) {
+					auto& workspace = workspaces[worker];
+					auto& mark = marks[worker];
+					const auto src = queries[order[groups[group]]].first;
+					size_t remaining = 0;
+
+					mark.resize(nodes.size(), 0);
+					for (auto i = groups[group]; i < groups[group + 1]; ++i)
+						if (mark[queries[order[i]].second] != group + 1) {
+							mark[queries[order[i]].second] = group + 1;
+							++remaining;
+						}
+
+					workspace.reset(nodes.size(), src);
+					expand(workspace, [&](vertex_id v) { return mark[v] == group + 1 && --remaining == 0; });
+
+					for (auto i = groups[group]; i < groups[group + 1]; ++i)
+						if (workspace.settled[queries[order[i]].second])
+							results[order[i]] = workspace.path(src, queries[order[i]].second);
+				});
+
+				return results;
+			}
+
+			/*
+			* Converts the labels of a batch of queries to identifiers, asserting each query can start.
+			*
+			* @param	queries	the labels of the source and destination nodes of each query
+			* @return	the identifiers of the source and destination nodes of each query
 			*/
-			inline W get_distance(fibonacci_heap<pair<string, W>, compare<comparator>>& heap, string label) const {
-				auto it = find_if(heap.begin(), heap.end(), [&](const auto& e) { return get<0>(e) == label; });
+			vector<pair<vertex_id, vertex_id>> identifiers(const vector<pair<string_view, string_view>>& queries) const {
+				auto result = vector<pair<vertex_id, vertex_id>>();
 
-				return it != heap.end() ? it->second : numeric_limits<W>::max();
+				result.reserve(queries.size());
+				for (const auto& [src, dst] : queries) {
+					assertions(src, dst);
+					result.emplace_back(id(src), id(dst));
+				}
+
+				return result;
 			}
 
 			/*
@@ -282,7 +2370,7 @@ namespace dijkstra {
 			* @param	src	the label of the source node
 			* @param	dst	the label of the destination node
 			*/
-			inline void assertions(string src, string dst) const {
+			inline void assertions([[maybe_unused]] string_view src, [[maybe_unused]] string_view dst) const {
 				assert(("The graph is empty", !empty()));
 				assert(("The source node is not in the graph", contains(src)));
 				assert(("The destination node is not in the graph", contains(dst)));
@@ -290,25 +2378,18 @@ namespace dijkstra {
 			}
 
 			/*
-			* Transforms the predecessors into a path.
+			* Performs quick assertions to ensure the search for the shortest path can start (but not if it will succeed).
 			*
-			* @param	preds	the map of node predecessors
-			* @param	src	the label of the source node
-			* @param	dst	the label of the destination node
-			* @return	a path from src to dst
+			* @param	src	the identifier of the source node
+			* @param	dst	the identifier of the destination node
 			*/
-			fs::path preds_to_path(const map<string, string>& preds, string src, string dst) const {
-				vector<string> reverse_path = { dst };
-				while (reverse_path.back() != src)
-					reverse_path.push_back(preds.at(reverse_path.back()));
-
-				auto _path = fs::path();
-				for (auto it = reverse_path.rbegin(); it != reverse_path.rend(); it++)
-					_path /= *it;
-
-				return _path;
+			inline void assertions([[maybe_unused]] vertex_id src, [[maybe_unused]] vertex_id dst) const {
+				assert(("The graph is empty", !empty()));
+				assert(("The source node is not in the graph", contains(src)));
+				assert(("The destination node is not in the graph", contains(dst)));
+				assert(("The source and destination are the same", dst != src));
 			}
 	};
 };
 
-#endif
\ No newline at end of file
+#endif
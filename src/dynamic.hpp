@@ -0,0 +1,233 @@
+#ifndef DYNAMIC_HPP
+#define DYNAMIC_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "dijkstra.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description A shortest path tree that follows the changes of the edge weights of a Graph, repairing only the nodes whose distance may change.
+ *	An edge that becomes heavier only affects the subtree below it if it is an edge of the tree: these nodes lose their distance,
+ *	and take the best one offered by their neighbors outside the subtree. An edge that becomes lighter only affects the nodes it brings closer.
+ *	Both kinds of changes then propagate from the nodes they touch in a single Dijkstra search, that stops as soon as no distance improves.
+ * @cite	@article{ramalingam1996incremental, title={An incremental algorithm for a generalization of the shortest-path problem}, author={Ramalingam, Ganesan and Reps, Thomas}, journal={Journal of Algorithms}, volume={21}, number={2}, pages={267--305}, year={1996}}
+ */
+namespace dijkstra {
+	using namespace std;
+
+	/*
+	* The shortest paths from one source to every node of a graph, kept up to date through update().
+	* The weights of the graph must only change through update() while the tree is alive, and the nodes added after its construction are ignored.
+	*
+	* @param	W	the type of the weights
+	* @param	Queue	the priority queue policy of the repairs, among the ones of heaps.hpp
+	*/
+	template <typename W = uint_fast32_t, template <typename> class Queue = FibonacciHeap>
+	class DynamicShortestPathTree {
+		private:
+			Graph<W>& graph;
+			vertex_id src;
+			size_t n;
+			ShortestPathTree<W> _tree;
+			vector<vector<vertex_id>> incoming;
+			vector<bool> affected;
+			Queue<W> queue;
+
+		public:
+			/*
+			* Constructor, that computes the tree from scratch.
+			*
+			* @param	graph	the graph, whose weights are changed by update()
+			* @param	src	the identifier of the source node
+			*/
+			DynamicShortestPathTree(Graph<W>& graph, vertex_id src) : graph(graph), src(src), n(graph.get_nodes().size()), affected(n, false) {
+				_tree = graph.template shortest_path_tree<Queue>(src);
+
+				// the edges of an unoriented graph are read from both ends, which makes the incoming edges those of the node itself
+				if (graph.get_orientation() == Orientation::ORIENTED) {
+					incoming.resize(n);
+					for (vertex_id v = 0; v < n; ++v)
+						for (const auto& [neighbor, _] : graph.get_nodes()[v].neighbors)
+							incoming[neighbor].push_back(v);
+				}
+			}
+
+			/*
+			* Returns the shortest path tree.
+			*
+			* @return	the distance and predecessor of every node, indexed by identifier
+			*/
+			inline const ShortestPathTree<W>& tree() const noexcept {
+				return _tree;
+			}
+
+			/*
+			* Returns the distance of a node from the source.
+			*
+			* @param	v	the identifier
+			* @return	the distance, or numeric_limits<W>::max() if v is unreachable
+			*/
+			inline W distance(vertex_id v) const {
+				return _tree.distances.at(v);
+			}
+
+			/*
+			* Returns the shortest path from the source to a node, asserting it exists.
+			*
+			* @param	dst	the identifier of the destination node
+			* @return	a path that starts with the source and ends with dst
+			*/
+			Path<W> find(vertex_id dst) const {
+				assert(("The destination is unreachable", distance(dst) != numeric_limits<W>::max()));
+
+				return Path<W>::from_preds(_tree.preds, _tree.distances, src, dst);
+			}
+
+			/*
+			* Sets the weights of a batch of edges in the graph, adding the edges that do not exist yet, and repairs the tree.
+			*
+			* @param	updates	the first node, second node and new weight of each edge, by identifier
+			* @return	the number of nodes settled by the repair
+			*/
+			size_t update(const vector<tuple<vertex_id, vertex_id, W>>& updates) {
+				for (const auto& [v0, v1, _] : updates) {
+					assert(("The first node is not in the tree", v0 < n && graph.contains(v0)));
+					assert(("The second node is not in the tree", v1 < n && graph.contains(v1)));
+
+					if (!incoming.empty() && !graph.has_neighbor(v0, v1))
+						incoming[v1].push_back(v0);
+				}
+
+				graph.update_weights(updates);
+				queue.reset(n);
+
+				// the heavier edges of the tree first, so that the lighter edges are relaxed from exact distances only
+				auto roots = vector<vertex_id>();
+				for (const auto& [v0, v1, _] : updates) {
+					if (is_heavier(v0, v1))
+						roots.push_back(v1);
+					if (graph.get_orientation() == Orientation::UNORIENTED && is_heavier(v1, v0))
+						roots.push_back(v0);
+				}
+
+				const auto subtree = invalidate(roots);
+
+				for (const auto v : subtree)
+					for_each_incoming(v, [&](vertex_id u, W weight) {
+						relax(u, v, weight);
+					});
+
+				for (const auto& [v0, v1, _] : updates) {
+					relax(v0, v1, weight(v0, v1));
+					if (graph.get_orientation() == Orientation::UNORIENTED)
+						relax(v1, v0, weight(v1, v0));
+				}
+
+				for (const auto v : subtree)
+					affected[v] = false;
+
+				return propagate();
+			}
+
+		private:
+			/*
+			* Returns the weight of an existing edge.
+			*/
+			inline W weight(vertex_id u, vertex_id v) const {
+				return graph.get_nodes()[u].neighbors.at(v);
+			}
+
+			/*
+			* Checks if an edge of the tree no longer gives its distance to the node at its end.
+			*/
+			inline bool is_heavier(vertex_id u, vertex_id v) const {
+				return _tree.preds[v] == u && _tree.distances[u] + weight(u, v) > _tree.distances[v];
+			}
+
+			/*
+			* Calls visit(u, weight) with every edge towards a node.
+			*/
+			template <class Visitor>
+			inline void for_each_incoming(vertex_id v, Visitor&& visit) const {
+				if (incoming.empty())
+					for (const auto& [neighbor, weight] : graph.get_nodes()[v].neighbors)
+						visit(neighbor, weight);
+				else
+					for (const auto u : incoming[v])
+						visit(u, weight(u, v));
+			}
+
+			/*
+			* Removes the distance of every node in the subtrees of some nodes, whose children are their neighbors that they are the predecessor of.
+			*
+			* @param	roots	the roots of the subtrees
+			* @return	the nodes of the subtrees, marked as affected
+			*/
+			vector<vertex_id> invalidate(const vector<vertex_id>& roots) {
+				auto subtree = vector<vertex_id>();
+
+				for (const auto root : roots)
+					if (!affected[root]) {
+						affected[root] = true;
+						subtree.push_back(root);
+					}
+
+				for (size_t i = 0; i < subtree.size(); ++i)
+					for (const auto& [neighbor, _] : graph.get_nodes()[subtree[i]].neighbors)
+						if (!affected[neighbor] && _tree.preds[neighbor] == subtree[i]) {
+							affected[neighbor] = true;
+							subtree.push_back(neighbor);
+						}
+
+				for (const auto v : subtree) {
+					_tree.distances[v] = numeric_limits<W>::max();
+					_tree.preds[v] = static_cast<vertex_id>(n);
+				}
+
+				return subtree;
+			}
+
+			/*
+			* Pushes the node at the end of an edge if the edge brings it closer to the source.
+			*/
+			inline void relax(vertex_id u, vertex_id v, W weight) {
+				if (_tree.distances[u] != numeric_limits<W>::max() && _tree.distances[u] + weight < _tree.distances[v]) {
+					_tree.distances[v] = _tree.distances[u] + weight;
+					_tree.preds[v] = u;
+					queue.push(v, _tree.distances[v]);
+				}
+			}
+
+			/*
+			* Settles the nodes of the queue by increasing distance, relaxing their outgoing edges, until no distance improves.
+			*
+			* @return	the number of nodes settled
+			*/
+			size_t propagate() {
+				size_t settled = 0;
+
+				while (!queue.empty()) {
+					const auto [nearest, distance] = queue.top();
+					queue.pop();
+
+					// the queues without decrease of a distance leave the older items behind
+					if (distance > _tree.distances[nearest])
+						continue;
+
+					++settled;
+					for (const auto& [neighbor, weight] : graph.get_nodes()[nearest].neighbors)
+						relax(nearest, neighbor, weight);
+				}
+
+				return settled;
+			}
+	};
+};
+
+#endif
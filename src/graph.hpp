@@ -19,147 +19,20 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
-#include <any>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <exception>
-#include <iostream>
-#include <list>
+#include <iterator>
 #include <map>
 #include <optional>
 #include <set>
 #include <string>
-#include <typeinfo>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
-#define DEBUG(message) std::cout << message << std::endl;
-
 namespace graph {
-	// data types are created at compile-time, so I have to hard code them
-	// vertex_signifiance: significative
-		// vertex_uniqueness: unique
-			// edges_uniqueness: unique
-				// weightness: weighted
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_s_VU_u_EU_u_W_w_graph = std::map<vertex_data, std::map<std::map<std::any, std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					template<class vertex_data = unsigned int>
-					using VS_s_VU_u_EU_u_W_uw_graph = std::map<vertex_data, std::set<std::map<std::any, std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_s_VU_u_EU_u_W_mw_graph = std::map<vertex_data, std::map<std::map<std::any, std::any>::const_pointer, std::optional<edge_data>>>;
-			// edges_uniqueness: not_unique
-				// weightness: weighted
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_s_VU_u_EU_nu_W_w_graph = std::map<vertex_data, std::multimap<std::map<std::any, std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					template<class vertex_data = unsigned int>
-					using VS_s_VU_u_EU_nu_W_uw_graph = std::map<vertex_data, std::multiset<std::map<std::any, std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_s_VU_u_EU_nu_W_mw_graph = std::map<vertex_data, std::multimap<std::map<std::any, std::any>::const_pointer, std::optional<edge_data>>>;
-		// vertex_uniqueness: not_unique
-			// edges_uniqueness: unique
-				// weightness: weighted
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_s_VU_nu_EU_u_W_w_graph = std::multimap<vertex_data, std::map<std::multimap<std::any, std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					template<class vertex_data = unsigned int>
-					using VS_s_VU_nu_EU_u_W_uw_graph = std::multimap<vertex_data, std::set<std::multimap<std::any, std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_s_VU_nu_EU_u_W_mw_graph = std::multimap<vertex_data, std::map<std::multimap<std::any, std::any>::const_pointer, std::optional<edge_data>>>;
-			// edges_uniqueness: not_unique
-				// weightness: weighted
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_s_VU_nu_EU_nu_W_w_graph = std::multimap<vertex_data, std::multimap<std::multimap<std::any, std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					template<class vertex_data = unsigned int>
-					using VS_s_VU_nu_EU_nu_W_uw_graph = std::multimap<vertex_data, std::multiset<std::multimap<std::any, std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_s_VU_nu_EU_nu_W_mw_graph = std::multimap<vertex_data, std::multimap<std::multimap<std::any, std::any>::const_pointer, std::optional<edge_data>>>;
-	// vertex_signifiance: not_significative
-		// vertex_uniqueness: unique
-			// edges_uniqueness: unique
-				// weightness: weighted
-					template<class edge_data = unsigned int>
-					using VS_ns_VU_u_EU_u_W_w_graph = std::set<std::map<std::set<std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					using VS_ns_VU_u_EU_u_W_uw_graph = std::set<std::set<std::set<std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class edge_data = unsigned int>
-					using VS_ns_VU_u_EU_u_W_mw_graph = std::set<std::map<std::set<std::any>::const_pointer, std::optional<edge_data>>>;
-			// edges_uniqueness: not_unique
-				// weightness: weighted
-					template<class edge_data = unsigned int>
-					using VS_ns_VU_u_EU_nu_W_w_graph = std::set<std::multimap<std::set<std::any>::const_pointer, edge_data>>;
-					// weightness: unweighted
-					using VS_ns_VU_u_EU_nu_W_uw_graph = std::set<std::multiset<std::set<std::any>::const_pointer>>;
-					// weightness: mixed
-					template<class edge_data = unsigned int>
-					using VS_ns_VU_u_EU_nu_W_mw_graph = std::set<std::multimap<std::set<std::any>::const_pointer, std::optional<edge_data>>>;
-		// vertex_uniqueness: not_unique (if all the nodes are indexed based on their position in the container, is this part really necessary ?)
-			// edges_uniqueness: unique
-				// weightness: weighted
-					template<class edge_data = unsigned int>
-					using VS_ns_VU_nu_EU_u_W_w_graph = std::multiset<std::map<std::multiset<std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					using VS_ns_VU_nu_EU_u_W_uw_graph = std::multiset<std::set<std::multiset<std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class edge_data = unsigned int>
-					using VS_ns_VU_nu_EU_u_W_mw_graph = std::multiset<std::map<std::multiset<std::any>::const_pointer, std::optional<edge_data>>>;
-			// edges_uniqueness: not_unique
-				// weightness: weighted
-					template<class edge_data = unsigned int>
-					using VS_ns_VU_nu_EU_nu_W_w_graph = std::multiset<std::multimap<std::multiset<std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					using VS_ns_VU_nu_EU_nu_W_uw_graph = std::multiset<std::multiset<std::multiset<std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class edge_data = unsigned int>
-					using VS_ns_VU_nu_EU_nu_W_mw_graph = std::multiset<std::multimap<std::multiset<std::any>::const_pointer, std::optional<edge_data>>>;
-	// vertex_signifiance: mixed_signifiance
-		// vertex_uniqueness: unique
-			// edges_uniqueness: unique
-				// weightness: weighted
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_ms_VU_u_EU_u_W_w_graph = std::map<std::optional<vertex_data>, std::map<std::map<std::any, std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					template<class vertex_data = unsigned int>
-					using VS_ms_VU_u_EU_u_W_uw_graph = std::map<std::optional<vertex_data>, std::set<std::map<std::any, std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_ms_VU_u_EU_u_W_mw_graph = std::map<std::optional<vertex_data>, std::map<std::map<std::any, std::any>::const_pointer, std::optional<edge_data>>>;
-			// edges_uniqueness: not_unique
-				// weightness: weighted
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_ms_VU_u_EU_nu_W_w_graph = std::map<std::optional<vertex_data>, std::multimap<std::map<std::any, std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					template<class vertex_data = unsigned int>
-					using VS_ms_VU_u_EU_nu_W_uw_graph = std::map<std::optional<vertex_data>, std::multiset<std::map<std::any, std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_ms_VU_u_EU_nu_W_mw_graph = std::map<std::optional<vertex_data>, std::multimap<std::map<std::any, std::any>::const_pointer, std::optional<edge_data>>>;
-		// vertex_uniqueness: not_unique
-			// edges_uniqueness: unique
-				// weightness: weighted
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_ms_VU_nu_EU_u_W_w_graph = std::multimap<std::optional<vertex_data>, std::map<std::multimap<std::any, std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					template<class vertex_data = unsigned int>
-					using VS_ms_VU_nu_EU_u_W_uw_graph = std::multimap<std::optional<vertex_data>, std::set<std::multimap<std::any, std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_ms_VU_nu_EU_u_W_mw_graph = std::multimap<std::optional<vertex_data>, std::map<std::multimap<std::any, std::any>::const_pointer, std::optional<edge_data>>>;
-			// edges_uniqueness: not_unique
-				// weightness: weighted
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_ms_VU_nu_EU_nu_W_w_graph = std::multimap<std::optional<vertex_data>, std::multimap<std::multimap<std::any, std::any>::const_pointer, edge_data>>;
-				// weightness: unweighted
-					template<class vertex_data = unsigned int>
-					using VS_ms_VU_nu_EU_nu_W_uw_graph = std::multimap<std::optional<vertex_data>, std::multiset<std::multimap<std::any, std::any>::const_pointer>>;
-				// weightness: mixed
-					template<class vertex_data = unsigned int, class edge_data = unsigned int>
-					using VS_ms_VU_nu_EU_nu_W_mw_graph = std::multimap<std::optional<vertex_data>, std::multimap<std::multimap<std::any, std::any>::const_pointer, std::optional<edge_data>>>;
 	enum vertex_uniqueness : unsigned int {
 		unique_vertices,
 		not_unique_vertices
@@ -183,6 +56,10 @@ namespace graph {
 		unweighted,
 		mixed_weightness
 	};
+	enum edge_layout : unsigned int {
+		tree_edges,
+		flat_edges
+	};
 	class graph_incompatibility : public std::exception {
 		private:
 			std::string message = "The graphs do not have the same properties";
@@ -193,7 +70,7 @@ namespace graph {
 
 				if(!properties_1.empty() && !properties_2.empty()) {
 					message += ": ";
-					for(const auto[key, value] : properties_1) {
+					for(const auto& [key, value] : properties_1) {
 						if(value != properties_2.at(key))
 							message += (key + " ");
 					}
@@ -202,585 +79,501 @@ namespace graph {
 			}
 			virtual const char* what() const throw() { return message.c_str(); }
 	};
-	// using sets, maps, multisets, multimaps: emplacements non contigus en mémoire, itérateurs restent valides en insertion et en suppression
-	template<class vertex_data = unsigned int, class edge_data = unsigned int>
-	class abstract_graph {
+	// value of the vertices of a not_significative graph and of the edges of an unweighted graph, that takes no room in the containers
+	struct no_data {
+		inline bool operator==(const no_data&) const noexcept { return true; }
+		inline bool operator!=(const no_data&) const noexcept { return false; }
+		inline bool operator<(const no_data&) const noexcept { return false; }
+	};
+	// sorted vector of the edges leaving a vertex, a contiguous alternative to std::set, std::multiset, std::map and std::multimap
+	// a neighbor walk reads consecutive memory instead of chasing a pointer per edge, at the cost of an insertion or a removal linear in the degree
+	template<class key, class mapped, bool multi>
+	class flat_container {
+		// TYPES
+			public:
+				using key_type = key;
+				using value_type = std::conditional_t<std::is_same_v<mapped, no_data>, key, std::pair<key, mapped>>;
+				using iterator = typename std::vector<value_type>::iterator;
+				using const_iterator = typename std::vector<value_type>::const_iterator;
 		// ATTRIBUTES
 			private:
-				std::any container;
-				/* static */ unsigned int instances;
-				std::map<std::string, unsigned int> properties;
+				std::vector<value_type> items;
 		// MEMBERS
 			public:
-				// default constructor
-					abstract_graph(
-						vertex_signifiance v_s = not_significative, vertex_uniqueness v_u = unique_vertices,
-						edge_uniqueness e_u = unique_edges, weightness w = unweighted, orientation o = unoriented) {
-
-						properties = {
-							{ "vertex_signifiance", v_s },
-							{ "vertex_uniqueness", v_u },
-							{ "edge_uniqueness", e_u },
-							{ "weightness", w },
-							{ "orientation", o }
-						};
-
-						switch(v_s) {
-							case significative:
-								if(v_u == unique_vertices) {
-									if(e_u == unique_edges) {
-										switch(w) {
-											case weighted:
-												container = VS_s_VU_u_EU_u_W_w_graph<vertex_data, edge_data>();
-												break;
-											case unweighted:
-												container = VS_s_VU_u_EU_u_W_uw_graph<vertex_data>();
-												break;
-											case mixed_weightness:
-												container = VS_s_VU_u_EU_u_W_mw_graph<vertex_data, edge_data>();
-												break;
-										}
-									}
-									else {
-										switch(w) {
-											case weighted:
-												container = VS_s_VU_u_EU_nu_W_w_graph<vertex_data, edge_data>();
-												break;
-											case unweighted:
-												container = VS_s_VU_u_EU_nu_W_uw_graph<vertex_data>();
-												break;
-											case mixed_weightness:
-												container = VS_s_VU_u_EU_nu_W_mw_graph<vertex_data, edge_data>();
-												break;
-										}
-									}
-								}
-								else {
-									if(e_u == unique_edges) {
-										switch(w) {
-											case weighted:
-												container = VS_s_VU_nu_EU_u_W_w_graph<vertex_data, edge_data>();
-												break;
-											case unweighted:
-												container = VS_s_VU_nu_EU_u_W_uw_graph<vertex_data>();
-												break;
-											case mixed_weightness:
-												container = VS_s_VU_nu_EU_u_W_mw_graph<vertex_data, edge_data>();
-												break;
-										}
-									}
-									else {
-										switch(w) {
-											case weighted:
-												container = VS_s_VU_nu_EU_nu_W_w_graph<vertex_data, edge_data>();
-												break;
-											case unweighted:
-												container = VS_s_VU_nu_EU_nu_W_uw_graph<vertex_data>();
-												break;
-											case mixed_weightness:
-												container = VS_s_VU_nu_EU_nu_W_mw_graph<vertex_data, edge_data>();
-												break;
-										}
-									}
-								}
-								break;
-							case not_significative:
-								if(v_u == unique_vertices) {
-									if(e_u == unique_edges) {
-										switch(w) {
-											case weighted:
-												container = VS_ns_VU_u_EU_u_W_w_graph<edge_data>();
-												break;
-											case unweighted:
-												container = VS_ns_VU_u_EU_u_W_uw_graph();
-												break;
-											case mixed_weightness:
-												container = VS_ns_VU_u_EU_u_W_mw_graph<edge_data>();
-												break;
-										}
-									}
-									else {
-										switch(w) {
-											case weighted:
-												container = VS_ns_VU_u_EU_nu_W_w_graph<edge_data>();
-												break;
-											case unweighted:
-												container = VS_ns_VU_u_EU_nu_W_uw_graph();
-												break;
-											case mixed_weightness:
-												container = VS_ns_VU_u_EU_nu_W_mw_graph<edge_data>();
-												break;
-										}
-									}
-								}
-								else {
-									if(e_u == unique_edges) {
-										switch(w) {
-											case weighted:
-												container = VS_ns_VU_nu_EU_u_W_w_graph<edge_data>();
-												break;
-											case unweighted:
-												container = VS_ns_VU_nu_EU_u_W_uw_graph();
-												break;
-											case mixed_weightness:
-												container = VS_ns_VU_nu_EU_u_W_mw_graph<edge_data>();
-												break;
-										}
-									}
-									else {
-										switch(w) {
-											case weighted:
-												container = VS_ns_VU_nu_EU_nu_W_w_graph<edge_data>();
-												break;
-											case unweighted:
-												container = VS_ns_VU_nu_EU_nu_W_uw_graph();
-												break;
-											case mixed_weightness:
-												container = VS_ns_VU_nu_EU_nu_W_mw_graph<edge_data>();
-												break;
-										}
-									}
-								}
-								break;
-							case mixed_signifiance:
-								if(v_u == unique_vertices) {
-									if(e_u == unique_edges) {
-										switch(w) {
-											case weighted:
-												container = VS_ms_VU_u_EU_u_W_w_graph<vertex_data, edge_data>();
-												break;
-											case unweighted:
-												container = VS_ms_VU_u_EU_u_W_uw_graph<vertex_data>();
-												break;
-											case mixed_weightness:
-												container = VS_ms_VU_u_EU_u_W_mw_graph<vertex_data, edge_data>();
-												break;
-										}
-									}
-									else {
-										switch(w) {
-											case weighted:
-												container = VS_ms_VU_u_EU_nu_W_w_graph<vertex_data, edge_data>();
-												break;
-											case unweighted:
-												container = VS_ms_VU_u_EU_nu_W_uw_graph<vertex_data>();
-												break;
-											case mixed_weightness:
-												container = VS_ms_VU_u_EU_nu_W_mw_graph<vertex_data, edge_data>();
-												break;
-										}
-									}
-								}
-								else {
-									if(e_u == unique_edges) {
-										switch(w) {
-											case weighted:
-												container = VS_ms_VU_nu_EU_u_W_w_graph<vertex_data, edge_data>();
-												break;
-											case unweighted:
-												container = VS_ms_VU_nu_EU_u_W_uw_graph<vertex_data>();
-												break;
-											case mixed_weightness:
-												container = VS_ms_VU_nu_EU_u_W_mw_graph<vertex_data, edge_data>();
-												break;
-										}
-									}
-									else {
-										switch(w) {
-											case weighted:
-												container = VS_ms_VU_nu_EU_nu_W_w_graph<vertex_data, edge_data>();
-												break;
-											case unweighted:
-												container = VS_ms_VU_nu_EU_nu_W_uw_graph<vertex_data>();
-												break;
-											case mixed_weightness:
-												container = VS_ms_VU_nu_EU_nu_W_mw_graph<vertex_data, edge_data>();
-												break;
-										}
-									}
-								}
-								break;
+				// iterators, by increasing key
+					inline iterator begin() noexcept { return items.begin(); }
+					inline iterator end() noexcept { return items.end(); }
+					inline const_iterator begin() const noexcept { return items.begin(); }
+					inline const_iterator end() const noexcept { return items.end(); }
+				// number of items
+					inline std::size_t size() const noexcept { return items.size(); }
+				// check if empty
+					inline bool empty() const noexcept { return items.empty(); }
+				// removes every item
+					inline void clear() noexcept { items.clear(); }
+				// finds an item by its key, or the first one if the keys are not unique
+					inline iterator find(const key& k) {
+						const auto it = lower_bound(k);
+						return it != items.end() && key_of(*it) == k ? it : items.end();
+					}
+					inline const_iterator find(const key& k) const {
+						const auto it = lower_bound(k);
+						return it != items.end() && key_of(*it) == k ? it : items.end();
+					}
+				// number of items having a key
+					inline std::size_t count(const key& k) const {
+						const auto [first, last] = equal_range(k);
+						return static_cast<std::size_t>(last - first);
+					}
+				// items having a key
+					inline std::pair<iterator, iterator> equal_range(const key& k) {
+						const auto first = lower_bound(k);
+						return { first, std::find_if(first, items.end(), [&k](const value_type& item) { return key_of(item) != k; }) };
+					}
+					inline std::pair<const_iterator, const_iterator> equal_range(const key& k) const {
+						const auto first = lower_bound(k);
+						return { first, std::find_if(first, items.end(), [&k](const value_type& item) { return key_of(item) != k; }) };
+					}
+				// adds an item after the ones having the same key, unless the keys are unique and there is one already
+					std::pair<iterator, bool> insert(const value_type& item) {
+						auto it = lower_bound(key_of(item));
+
+						if constexpr(multi) {
+							while(it != items.end() && key_of(*it) == key_of(item))
+								++it;
 						}
+						else if(it != items.end() && key_of(*it) == key_of(item))
+							return { it, false };
 
-						++instances;
-					}
-				// copy constructor
-					abstract_graph(const abstract_graph& rhs) : container(rhs.container), properties(rhs.properties) { ++instances; }
-				// move constructor
-					abstract_graph(abstract_graph&& rhs) noexcept {
-						container = std::move(rhs.container);
-						properties = std::move(rhs.properties);
-					}
-				// destructor
-					~abstract_graph() noexcept { --instances; }
-				// operators
-					// arithmetic operators
-						// basic assignation
-							abstract_graph& operator=(const abstract_graph& rhs) {
-								container = rhs.container;
-								properties = rhs.properties;
-								return &this;
-							}
-						// move assignment operator
-							abstract_graph& operator=(abstract_graph&& other) noexcept {
-								container = std::move(other.container);
-								properties = std::move(rhs.properties);
-								return *this;
-							}
-						// add vertices and edges
-							abstract_graph operator+(const abstract_graph& rhs) {
-								if(!isCompatible(rhs)) {
-									try {
-										throw graph_incompatibility(properties, rhs.properties);
-									}
-									catch(std::exception& e) {
-										std::cout << e.what() << std::endl;
-									}
-								}
-								
-								auto data = casted_container();
-								DEBUG(data);
-								//casted_container.merge(rhs.casted_container());
-								// check stuff
-
-								return *this;
-							}
-						// remove vertices and edges if they exist
-							abstract_graph* operator-(const abstract_graph& rhs) {
-								if(!isCompatible(rhs))
-									throw graph_incompatibility(properties, rhs.properties);
-								for(vertex_data element : rhs.container)
-									container.erase(element);
-								// check the edges
+						return { items.insert(it, item), true };
+					}
+					template<class... arguments>
+					inline std::pair<iterator, bool> emplace(arguments&&... args) { return insert(value_type(std::forward<arguments>(args)...)); }
+				// adds an item right before hint if it belongs there, as when the items come in order, or where it belongs otherwise
+					iterator insert(const_iterator hint, const value_type& item) {
+						const bool after_previous = hint == items.begin() || !(key_of(item) < key_of(*std::prev(hint)));
+						const bool before_next = hint == items.end() || !(key_of(*hint) < key_of(item));
 
+						if(!after_previous || !before_next)
+							return insert(item).first;
+						if constexpr(!multi) {
+							if(hint != items.begin() && key_of(*std::prev(hint)) == key_of(item))
+								return items.begin() + (hint - items.begin()) - 1;
+							if(hint != items.end() && key_of(*hint) == key_of(item))
+								return items.begin() + (hint - items.begin());
+						}
 
-								return this;
-							}
-					// bitwise operators
-						// invert links orientation in oriented graphs
-							abstract_graph* operator~() {
-								if(properties.at("orientation") == oriented) {
+						return items.insert(hint, item);
+					}
+				// removes the items having a key, and returns their number
+					std::size_t erase(const key& k) {
+						const auto [first, last] = equal_range(k);
+						const auto count = static_cast<std::size_t>(last - first);
 
-								}
-								return this;
-							}
-						// intersection
-							void operator&(const abstract_graph& rhs) {}
-						// union
-							void operator|(const abstract_graph& rhs) {}
-						// difference
-							void operator^(const abstract_graph& rhs) {}
-					// comparison/relational operators
-						// compare vertices and edges
-							bool operator==(const abstract_graph& rhs) {
-
-								// check properties
-								try {
-									if(!std::equal(properties.cbegin(), properties.cend(), rhs.properties.cbegin()))
-										return false;
-								}
-								catch(std::bad_alloc e) {
-									e.what();
-								}
-
-								// maybe replace all the code below
-								/*
-								try {
-								if(!std::equal(container.cbegin(), container.cend(), rhs.container.cbegin()))
-								return false;
-								}
-								catch(std::bad_alloc e) {
-								e.what();
-								}
-								*/
-
-								// check if size of the containers
-								if(container.size() != rhs.container.size())
-									return false;
-								// check if number of keys
-								if(std::set<vertex_data> keys_set(container), keys_set_rhs(rhs.container);  keys_set.size() != keys_set_rhs.size())
-									return false;
-								// check if number of each key
-								for(const auto& element : keys_set) {
-									if(container.count(element) != rhs.container.count(element))
-										return false;
-								}
-								// iterate through vertices
-								auto it_rhs = rhs.container.begin();
-								for(auto it = container.cbegin(); it != container.end(); ++it) {
-									// check if size of the edges containers
-									if(it->second.size() != it_rhs->second.size())
-										return false;
-									// check if number of keys
-									if(std::set<vertex_data> keys_set(container), keys_set_rhs(rhs.container);  keys_set.size() != keys_set_rhs.size())
-										return false;
-									// check if number of each key
-									for(const auto& element : keys_set) {
-										if(container.count(element) != rhs.container.count(element))
-											return false;
-									}
-									// iterate through edges
-									auto it2_rhs = it_rhs->second.begin();
-									for(auto it2 = it->second.begin(); it2 != it->second.end(); ++it2) {
-										// check if the weight exists
-										if(it2->second xor it2_rhs->second)
-											return false;
-										// check if the weight is the same
-										if(it2->second != it2_rhs->second)
-											return false;
-										++it2_rhs;
-									}
+						items.erase(first, last);
+						return count;
+					}
+			private:
+				// returns the key of an item
+					static inline const key& key_of(const value_type& item) noexcept {
+						if constexpr(std::is_same_v<mapped, no_data>)
+							return item;
+						else
+							return item.first;
+					}
+				// returns the first item whose key is not less than k
+					inline iterator lower_bound(const key& k) {
+						return std::lower_bound(items.begin(), items.end(), k, [](const value_type& item, const key& other) { return key_of(item) < other; });
+					}
+					inline const_iterator lower_bound(const key& k) const {
+						return std::lower_bound(items.begin(), items.end(), k, [](const value_type& item, const key& other) { return key_of(item) < other; });
+					}
+	};
+	// storage of a graph, resolved at compile time from its properties instead of being picked at runtime among 36 containers held in a std::any
+	// the vertices are identified by their position, so that the edges refer to them without pointers into the containers
+	template<vertex_signifiance v_s, vertex_uniqueness v_u, edge_uniqueness e_u, weightness w, class vertex_data, class edge_data, edge_layout e_l = tree_edges>
+	struct storage {
+		// value of a vertex
+		using vertex_value = std::conditional_t<v_s == significative, vertex_data, std::conditional_t<v_s == mixed_signifiance, std::optional<vertex_data>, no_data>>;
+		// value of an edge
+		using edge_value = std::conditional_t<w == weighted, edge_data, std::conditional_t<w == mixed_weightness, std::optional<edge_data>, no_data>>;
+		// edges leaving a vertex, keyed by the position of the vertex they lead to, in a tree or in a sorted vector
+		using edges = std::conditional_t<e_l == flat_edges,
+			flat_container<std::size_t, std::conditional_t<w == unweighted, no_data, edge_value>, e_u == not_unique_edges>,
+			std::conditional_t<w == unweighted,
+				std::conditional_t<e_u == unique_edges, std::set<std::size_t>, std::multiset<std::size_t>>,
+				std::conditional_t<e_u == unique_edges, std::map<std::size_t, edge_value>, std::multimap<std::size_t, edge_value>>>>;
+		// positions of the vertices by value, only for the vertices that have one
+		using index = std::conditional_t<v_s == not_significative, no_data,
+			std::conditional_t<v_u == unique_vertices, std::map<vertex_data, std::size_t>, std::multimap<vertex_data, std::size_t>>>;
+	};
+	/*
+	The basic operations provided by a graph data structure G usually include:
+		adjacent(x, y): tests whether there is an edge from the vertex x to the vertex y
+		neighbors(x): lists all vertices y such that there is an edge from the vertex x to the vertex y
+		add_vertex(x): adds the vertex x, if it is not there
+		remove_vertex(x): removes the vertex x, if it is there
+		add_edge(x, y): adds the edge from the vertex x to the vertex y, if it is not there
+		remove_edge(x, y): removes the edge from the vertex x to the vertex y, if it is there
+		get_vertex_value(x): returns the value associated with the vertex x
+		set_vertex_value(x, v): sets the value associated with the vertex x to v
 
-									++it_rhs;
-								}
-								return true;
-							}
-						// compare vertices and edges
-							inline bool operator!=(const abstract_graph& rhs) { return !(this == rhs); }
-						// compare number of vertices
-							inline bool operator>(const abstract_graph& rhs) const { return container.size() > rhs.container.size(); }
-						// compare number of vertices
-							inline bool operator<(const abstract_graph& rhs) const { return container.size() < rhs.container.size(); }
-						// compare number of vertices
-							inline bool operator>=(const abstract_graph& rhs) const { return !(this < rhs); }
-						// compare number of vertices
-							inline bool operator<=(const abstract_graph& rhs) const { return !(this > rhs); }
-						// compare number of vertices ( ͡° ͜ʖ ͡°) (C++20)
-							//bool operator<=>(const abstract_graph& rhs) const {}
-					// compound assignment operators
-						// add vertices and edges
-							inline abstract_graph& operator+=(const abstract_graph& rhs) { return this + rhs; }
-						// remove vertices and edges if they exist
-							inline abstract_graph& operator-=(const abstract_graph& rhs) { return this - rhs; }
-						// intersection
-							inline abstract_graph& operator&=(const abstract_graph& rhs) { return this & rhs; }
-						// union
-							inline abstract_graph& operator|=(const abstract_graph& rhs) { return this | rhs; }
-						// difference
-							inline abstract_graph& operator^=(const abstract_graph& rhs) { return this ^ rhs; }
-					// logical operators
-						// check if empty
-							inline bool operator!() { return container.empty(); }
-						// check if the two graphs are not empty
-							inline bool operator&&(const abstract_graph& rhs) { return !(container.empty() || rhs.container.empty()); }
-						// check if one of the two graphs is not empty
-							inline bool operator||(const abstract_graph& rhs) { return !(container.empty() && rhs.container.empty()); }
-				// graph operations
-					// check compatibility of the properties
-						bool isCompatible(const abstract_graph& rhs) const { return properties == rhs.properties; }
-					// tests whether there is an edge from the vertex x to the vertex y
-						bool adjacent(vertex_data vertex_1, vertex_data vertex_2, unsigned int index_1 = 0, unsigned int index_2 = 0) {
-							if(properties.at("orientation") == oriented) {
-								/*
-								container.at(vertex_1).second
-									std::max(vertex_1, vertex_2);
-								*/
-							}
-							else {
+	Structures that associate values to the edges usually also provide:
+		get_edge_value(x, y): returns the value associated with the edge (x, y)
+		set_edge_value(x, y, v): sets the value associated with the edge (x, y) to v
+	*/
+	// graph whose properties are template parameters: every operation picks its behavior with if constexpr, and inlines with no type erasure
+	// the edges of a vertex are kept in a tree by default, or in a sorted vector with flat_edges for the graphs that are walked more than they are modified
+	template<vertex_signifiance v_s, vertex_uniqueness v_u, edge_uniqueness e_u, weightness w, orientation o, class vertex_data = unsigned int, class edge_data = unsigned int, edge_layout e_l = tree_edges>
+	class graph {
+		// TYPES
+			public:
+				using types = storage<v_s, v_u, e_u, w, vertex_data, edge_data, e_l>;
+				using vertex = std::size_t;
+				using vertex_value = typename types::vertex_value;
+				using edge_value = typename types::edge_value;
+				using edges = typename types::edges;
+				using index = typename types::index;
+				// orientation of an edge when it is not given, only meaningful in a graph of mixed orientation
+				static constexpr orientation default_orientation = o == mixed_orientation ? unoriented : o;
+		// ATTRIBUTES
+			private:
+				std::vector<vertex_value> values;
+				// edges leaving each vertex, an unoriented edge being stored from both of its ends
+				std::vector<edges> adjacency;
+				std::vector<bool> removed;
+				index positions;
+				std::size_t vertices = 0;
+		// MEMBERS
+			public:
+				// properties of the graph
+					static constexpr vertex_signifiance vertex_signifiance_property = v_s;
+					static constexpr vertex_uniqueness vertex_uniqueness_property = v_u;
+					static constexpr edge_uniqueness edge_uniqueness_property = e_u;
+					static constexpr weightness weightness_property = w;
+					static constexpr orientation orientation_property = o;
+					static constexpr edge_layout edge_layout_property = e_l;
+				// number of vertices
+					inline std::size_t size() const noexcept { return vertices; }
+				// check if empty
+					inline bool empty() const noexcept { return vertices == 0; }
+				// check if a vertex is in the graph
+					inline bool contains(vertex x) const noexcept { return x < removed.size() && !removed[x]; }
+				// tests whether there is an edge from the vertex x to the vertex y
+					inline bool adjacent(vertex x, vertex y) const {
+						assert(("The vertex is not in the graph", contains(x) && contains(y)));
 
-							}
-							return false;
+						return adjacency[x].find(y) != adjacency[x].end();
+					}
+				// lists all vertices y such that there is an edge from the vertex x to the vertex y, with the value of the edge unless the graph is unweighted
+					inline const edges& neighbors(vertex x) const {
+						assert(("The vertex is not in the graph", contains(x)));
+
+						return adjacency[x];
+					}
+				// finds a vertex by its value, or any of them if the vertices are not unique
+					std::optional<vertex> find_vertex(const vertex_data& value) const {
+						static_assert(v_s != not_significative, "The vertices have no value");
+
+						if(const auto it = positions.find(value); it != positions.end())
+							return it->second;
+						return {};
+					}
+				// adds the vertex x, if it is not there: a vertex with the same value is returned instead if the vertices are unique
+					std::pair<vertex, bool> add_vertex(const vertex_value& value = vertex_value()) {
+						if constexpr(v_s != not_significative && v_u == unique_vertices) {
+							if(const auto existing = lookup(value))
+								return { *existing, false };
 						}
-						bool adjacent(unsigned int vertex_1, unsigned int vertex_2) {
-							if(properties.at("orientation") == oriented) {
-								/*
-								container.at(vertex_1).second
-									std::max(vertex_1, vertex_2);
-								*/
-							}
-							else {
 
-							}
+						const vertex x = values.size();
+						values.push_back(value);
+						adjacency.emplace_back();
+						removed.push_back(false);
+						index_vertex(x);
+						++vertices;
+
+						return { x, true };
+					}
+				// removes the vertex x, if it is there, with the edges leading to it
+					bool remove_vertex(vertex x) {
+						if(!contains(x))
 							return false;
-						}
-					// adds the vertex x, if it is not there
-						std::optional<std::any> add_vertex(const vertex_data& element) {
-							if(properties.at(orientation) == oriented) {
 
-							}
-							/*
-							if(auto result = container.insert(element); result.second)
-								return result.first;
-							*/
-							return {};
+						if constexpr(o == unoriented) {
+							for(const auto& edge : adjacency[x])
+								if(target(edge) != x)
+									adjacency[target(edge)].erase(x);
 						}
-						std::optional<std::any> add_vertex(vertex_data&& element) {
-							/*
-							if(auto result = container.insert(element); result.second)
-								return result.first;
-							*/
-							return {};
+						else {
+							for(vertex y = 0; y < adjacency.size(); ++y)
+								if(y != x)
+									adjacency[y].erase(x);
 						}
-					// lists all vertices y such that there is an edge from the vertex x to the vertex y
-						std::list<std::any> neightbors(const vertex_data& element) const {
 
-						}
-						std::list<std::any> neightbors(vertex_data&& element) const {
+						unindex_vertex(x);
+						adjacency[x].clear();
+						values[x] = vertex_value();
+						removed[x] = true;
+						--vertices;
 
+						return true;
+					}
+				// adds the edge from the vertex x to the vertex y, if it is not there or if the edges are not unique
+					bool add_edge(vertex x, vertex y, const edge_value& value = edge_value(), orientation edge_orientation = default_orientation) {
+						assert(("The vertex is not in the graph", contains(x) && contains(y)));
+						assert(("The orientation of an edge can only be chosen in a graph of mixed orientation", o == mixed_orientation || edge_orientation == o));
+
+						if constexpr(e_u == unique_edges) {
+							if(adjacent(x, y))
+								return false;
 						}
-						std::list<std::any> neightbors(std::set<std::any>::iterator& element) const {
 
+						insert(x, y, value);
+						if(edge_orientation == unoriented && x != y)
+							insert(y, x, value);
+
+						return true;
+					}
+				// removes the edges from the vertex x to the vertex y, if they are there, and returns their number
+					std::size_t remove_edge(vertex x, vertex y, orientation edge_orientation = default_orientation) {
+						assert(("The vertex is not in the graph", contains(x) && contains(y)));
+						assert(("The orientation of an edge can only be chosen in a graph of mixed orientation", o == mixed_orientation || edge_orientation == o));
+
+						const auto count = adjacency[x].erase(y);
+						if(edge_orientation == unoriented && x != y)
+							adjacency[y].erase(x);
+
+						return count;
+					}
+				// returns the value associated with the vertex x
+					inline const vertex_value& get_vertex_value(vertex x) const {
+						static_assert(v_s != not_significative, "The vertices have no value");
+						assert(("The vertex is not in the graph", contains(x)));
+
+						return values[x];
+					}
+				// sets the value associated with the vertex x to v, unless another vertex has this value and the vertices are unique
+					bool set_vertex_value(vertex x, const vertex_value& value) {
+						static_assert(v_s != not_significative, "The vertices have no value");
+						assert(("The vertex is not in the graph", contains(x)));
+
+						if constexpr(v_u == unique_vertices) {
+							if(const auto existing = lookup(value); existing && *existing != x)
+								return false;
 						}
-						std::list<std::any> neightbors(std::map<std::any, std::any>::iterator& element) const {
 
+						unindex_vertex(x);
+						values[x] = value;
+						index_vertex(x);
+
+						return true;
+					}
+				// returns the value associated with the edge (x, y), or the first one if the edges are not unique
+					std::optional<edge_value> get_edge_value(vertex x, vertex y) const {
+						static_assert(w != unweighted, "The edges have no value");
+						assert(("The vertex is not in the graph", contains(x) && contains(y)));
+
+						if(const auto it = adjacency[x].find(y); it != adjacency[x].end())
+							return it->second;
+						return {};
+					}
+				// sets the value associated with the edges (x, y) to v, and returns their number
+					std::size_t set_edge_value(vertex x, vertex y, const edge_value& value, orientation edge_orientation = default_orientation) {
+						static_assert(w != unweighted, "The edges have no value");
+						assert(("The vertex is not in the graph", contains(x) && contains(y)));
+
+						std::size_t count = 0;
+						for(auto [it, end] = adjacency[x].equal_range(y); it != end; ++it, ++count)
+							it->second = value;
+						if(edge_orientation == unoriented && x != y)
+							for(auto [it, end] = adjacency[y].equal_range(x); it != end; ++it)
+								it->second = value;
+
+						return count;
+					}
+			// operators
+				// set algebra, matching the vertices of both graphs by position and their edges by target, with the values of this graph winning over the ones of rhs
+				// each adjacency is merged in linear time with the one of rhs, so that a compound operator never copies more than the edges of one vertex at a time
+					// union of the vertices and of the edges
+						inline graph& operator|=(const graph& rhs) {
+							add_vertices(rhs);
+							combine<union_of>(rhs);
+							return *this;
 						}
-			/*
-			The basic operations provided by a graph data structure G usually include:
-				adjacent(x, y): tests whether there is an edge from the vertex x to the vertex y
-				remove_vertex(x): removes the vertex x, if it is there
-				add_edge(x, y): adds the edge from the vertex x to the vertex y, if it is not there
-				remove_edge(x, y): removes the edge from the vertex x to the vertex y, if it is there
-				get_vertex_value(x): returns the value associated with the vertex x
-				set_vertex_value(x, v): sets the value associated with the vertex x to v
-
-			Structures that associate values to the edges usually also provide:
-				get_edge_value(x, y): returns the value associated with the edge (x, y)
-				set_edge_value(x, y, v): sets the value associated with the edge (x, y) to v
-			*/
-
-			std::any casted_container() {
-				switch(properties.at("vertex_signifiance")) {
-					case significative:
-						if(properties.at("vertex_uniqueness") == unique_vertices) {
-							if(properties.at("edge_uniqueness") == unique_edges) {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_s_VU_u_EU_u_W_w_graph<vertex_data, edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_s_VU_u_EU_u_W_uw_graph<vertex_data>>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_s_VU_u_EU_u_W_mw_graph<vertex_data, edge_data>>(container);
-								}
-							}
-							else {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_s_VU_u_EU_nu_W_w_graph<vertex_data, edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_s_VU_u_EU_nu_W_uw_graph<vertex_data>>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_s_VU_u_EU_nu_W_mw_graph<vertex_data, edge_data>>(container);
-								}
-							}
+					// vertices of both graphs, with their edges in both graphs
+						inline graph& operator&=(const graph& rhs) {
+							keep_vertices(rhs);
+							combine<intersection_of>(rhs);
+							return *this;
 						}
-						else {
-							if(properties.at("edge_uniqueness") == unique_edges) {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_s_VU_nu_EU_u_W_w_graph<vertex_data, edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_s_VU_nu_EU_u_W_uw_graph<vertex_data>>(container);
-									case mixed_weightness:
-										return &std::any_cast< VS_s_VU_nu_EU_u_W_mw_graph<vertex_data, edge_data>>(container);
-								}
-							}
-							else {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_s_VU_nu_EU_nu_W_w_graph<vertex_data, edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_s_VU_nu_EU_nu_W_uw_graph<vertex_data>>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_s_VU_nu_EU_nu_W_mw_graph<vertex_data, edge_data>>(container);
-								}
-							}
+					// vertices of this graph, with their edges that are not in rhs
+						inline graph& operator-=(const graph& rhs) {
+							combine<difference_of>(rhs);
+							return *this;
 						}
-						break;
-					case not_significative:
-						if(properties.at("vertex_uniqueness") == unique_vertices) {
-							if(properties.at("edge_uniqueness") == unique_edges) {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_ns_VU_u_EU_u_W_w_graph<edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_ns_VU_u_EU_u_W_uw_graph>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_ns_VU_u_EU_u_W_mw_graph<edge_data>>(container);
-								}
-							}
-							else {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_ns_VU_u_EU_nu_W_w_graph<edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_ns_VU_u_EU_nu_W_uw_graph>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_ns_VU_u_EU_nu_W_mw_graph<edge_data>>(container);
-								}
-							}
+					// union of the vertices, with the edges that are in only one of the graphs
+						inline graph& operator^=(const graph& rhs) {
+							add_vertices(rhs);
+							combine<symmetric_difference_of>(rhs);
+							return *this;
 						}
-						else {
-							if(properties.at("edge_uniqueness") == unique_edges) {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_ns_VU_nu_EU_u_W_w_graph<edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_ns_VU_nu_EU_u_W_uw_graph>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_ns_VU_nu_EU_u_W_mw_graph<edge_data>>(container);
-								}
-							}
-							else {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_ns_VU_nu_EU_nu_W_w_graph<edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_ns_VU_nu_EU_nu_W_uw_graph>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_ns_VU_nu_EU_nu_W_mw_graph<edge_data>>(container);
-								}
+					inline graph operator|(const graph& rhs) const { return graph(*this) |= rhs; }
+					inline graph operator&(const graph& rhs) const { return graph(*this) &= rhs; }
+					inline graph operator-(const graph& rhs) const { return graph(*this) -= rhs; }
+					inline graph operator^(const graph& rhs) const { return graph(*this) ^= rhs; }
+				// compare vertices and edges, stopping at the first difference without allocating; the parallel edges are compared in the order of their insertion
+					bool operator==(const graph& rhs) const {
+						if(vertices != rhs.vertices)
+							return false;
+
+						for(vertex x = 0; x < std::max(adjacency.size(), rhs.adjacency.size()); ++x) {
+							if(contains(x) != rhs.contains(x))
+								return false;
+							if(!contains(x))
+								continue;
+							if constexpr(v_s != not_significative) {
+								if(!(values[x] == rhs.values[x]))
+									return false;
 							}
+							if(adjacency[x].size() != rhs.adjacency[x].size() || !std::equal(adjacency[x].begin(), adjacency[x].end(), rhs.adjacency[x].begin()))
+								return false;
 						}
-						break;
-					case mixed_signifiance:
-						if(properties.at("vertex_uniqueness") == unique_vertices) {
-							if(properties.at("edge_uniqueness") == unique_edges) {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_ms_VU_u_EU_u_W_w_graph<vertex_data, edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_ms_VU_u_EU_u_W_uw_graph<vertex_data>>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_ms_VU_u_EU_u_W_mw_graph<vertex_data, edge_data>>(container);
-								}
+
+						return true;
+					}
+					inline bool operator!=(const graph& rhs) const { return !(*this == rhs); }
+			private:
+				// the merges of the set algebra
+					enum set_operation : unsigned int {
+						union_of,
+						intersection_of,
+						difference_of,
+						symmetric_difference_of
+					};
+				// merges the edges of each vertex of this graph with the edges of the same vertex in rhs
+					template<set_operation operation>
+					void combine(const graph& rhs) {
+						static const edges none;
+						// reused from one vertex to the next, so that a flat layout only allocates while the largest adjacency grows
+						edges merged;
+
+						for(vertex x = 0; x < adjacency.size(); ++x) {
+							if(!contains(x))
+								continue;
+
+							auto& mine = adjacency[x];
+							const auto& theirs = rhs.contains(x) ? rhs.adjacency[x] : none;
+
+							if(theirs.empty()) {
+								if constexpr(operation == intersection_of)
+									mine.clear();
+								continue;
 							}
-							else {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_ms_VU_u_EU_nu_W_w_graph<vertex_data, edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_ms_VU_u_EU_nu_W_uw_graph<vertex_data>>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_ms_VU_u_EU_nu_W_mw_graph<vertex_data, edge_data>>(container);
-								}
+							if(mine.empty()) {
+								if constexpr(operation == union_of || operation == symmetric_difference_of)
+									mine = theirs;
+								continue;
 							}
+
+							merged.clear();
+							auto output = std::inserter(merged, merged.end());
+							if constexpr(operation == union_of)
+								std::set_union(mine.begin(), mine.end(), theirs.begin(), theirs.end(), output, before);
+							else if constexpr(operation == intersection_of)
+								std::set_intersection(mine.begin(), mine.end(), theirs.begin(), theirs.end(), output, before);
+							else if constexpr(operation == difference_of)
+								std::set_difference(mine.begin(), mine.end(), theirs.begin(), theirs.end(), output, before);
+							else
+								std::set_symmetric_difference(mine.begin(), mine.end(), theirs.begin(), theirs.end(), output, before);
+							std::swap(mine, merged);
 						}
-						else {
-							if(properties.at("edge_uniqueness") == unique_edges) {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_ms_VU_nu_EU_u_W_w_graph<vertex_data, edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_ms_VU_nu_EU_u_W_uw_graph<vertex_data>>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_ms_VU_nu_EU_u_W_mw_graph<vertex_data, edge_data>>(container);
-								}
+					}
+				// adds the vertices of rhs that are not in this graph, with their values
+					void add_vertices(const graph& rhs) {
+						if(rhs.adjacency.size() > adjacency.size()) {
+							values.resize(rhs.adjacency.size());
+							adjacency.resize(rhs.adjacency.size());
+							removed.resize(rhs.adjacency.size(), true);
+						}
+
+						for(vertex x = 0; x < rhs.adjacency.size(); ++x)
+							if(rhs.contains(x) && !contains(x)) {
+								if constexpr(v_s != not_significative && v_u == unique_vertices)
+									assert(("Another vertex has the value of a vertex of rhs", !lookup(rhs.values[x])));
+
+								values[x] = rhs.values[x];
+								removed[x] = false;
+								index_vertex(x);
+								++vertices;
 							}
-							else {
-								switch(properties.at("weightness")) {
-									case weighted:
-										return &std::any_cast<VS_ms_VU_nu_EU_nu_W_w_graph<vertex_data, edge_data>>(container);
-									case unweighted:
-										return &std::any_cast<VS_ms_VU_nu_EU_nu_W_uw_graph<vertex_data>>(container);
-									case mixed_weightness:
-										return &std::any_cast<VS_ms_VU_nu_EU_nu_W_mw_graph<vertex_data, edge_data>>(container);
-								}
+					}
+				// removes the vertices that are not in rhs, whose edges the intersection then removes from the other vertices
+					void keep_vertices(const graph& rhs) {
+						for(vertex x = 0; x < adjacency.size(); ++x)
+							if(contains(x) && !rhs.contains(x)) {
+								unindex_vertex(x);
+								adjacency[x].clear();
+								values[x] = vertex_value();
+								removed[x] = true;
+								--vertices;
 							}
+					}
+				// orders the edges by target
+					static inline bool before(const typename edges::value_type& lhs, const typename edges::value_type& rhs) noexcept {
+						return target(lhs) < target(rhs);
+					}
+				// returns the vertex at the end of an edge of the adjacency
+					static inline vertex target(const typename edges::value_type& edge) noexcept {
+						if constexpr(w == unweighted)
+							return edge;
+						else
+							return edge.first;
+					}
+				// adds an edge to the adjacency of x
+					inline void insert(vertex x, vertex y, const edge_value& value) {
+						if constexpr(w == unweighted)
+							adjacency[x].insert(y);
+						else
+							adjacency[x].emplace(y, value);
+					}
+				// finds the vertex having a value, if the value is not empty
+					inline std::optional<vertex> lookup(const vertex_value& value) const {
+						if constexpr(v_s == significative)
+							return find_vertex(value);
+						else if constexpr(v_s == mixed_signifiance)
+							return value ? find_vertex(*value) : std::nullopt;
+						else
+							return {};
+					}
+				// adds the value of a vertex to the index
+					inline void index_vertex(vertex x) {
+						if constexpr(v_s == significative)
+							positions.emplace(values[x], x);
+						else if constexpr(v_s == mixed_signifiance) {
+							if(values[x])
+								positions.emplace(*values[x], x);
 						}
-						break;
-				}
-			}
+					}
+				// removes the value of a vertex from the index
+					inline void unindex_vertex(vertex x) {
+						if constexpr(v_s != not_significative) {
+							const vertex_data* value = nullptr;
+
+							if constexpr(v_s == significative)
+								value = &values[x];
+							else if(values[x])
+								value = &*values[x];
+
+							if(value)
+								for(auto [it, end] = positions.equal_range(*value); it != end; ++it)
+									if(it->second == x) {
+										positions.erase(it);
+										break;
+									}
+						}
+					}
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,349 @@
+#ifndef HEAPS_HPP
+#define HEAPS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "boost/heap/fibonacci_heap.hpp"
+#include "boost/heap/pairing_heap.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Priority queue policies for the searches of dijkstra.hpp.
+ *	Every policy stores nodes identified by a vertex_id with a distance, and provides the same interface:
+ *	- reset(n) : empties the queue and prepares it for the identifiers lower than n, reusing its memory
+ *	- push(v, distance) : inserts v, or decreases its distance if it is already in the queue
+ *	- top(), pop() : accesses and removes the node with the smallest distance
+ *	- empty(), size()
+ *	Some policies do not support the decrease of a distance and insert a duplicate instead, so a search must skip the nodes it has already settled.
+ */
+namespace dijkstra {
+	using namespace std;
+
+	/*
+	* The integral identifier of a node in a frozen graph.
+	*/
+	using vertex_id = uint32_t;
+
+	/*
+	* An adapter around the mutable heaps of boost, which support the decrease of a distance through handles.
+	*
+	* @param	W	the type of the distances
+	* @param	Heap	a mutable heap of boost, such as fibonacci_heap or pairing_heap
+	*/
+	template <typename W, template <typename, typename...> class Heap>
+	class MutableHeap {
+		public:
+			/*
+			* The comparator for the items in the heap.
+			*/
+			struct comparator {
+				inline bool operator() (const pair<vertex_id, W>& lhs, const pair<vertex_id, W>& rhs) const {
+					return get<1>(lhs) > get<1>(rhs);
+				}
+			};
+		private:
+			using heap_type = Heap<pair<vertex_id, W>, boost::heap::compare<comparator>>;
+
+			heap_type heap;
+			vector<typename heap_type::handle_type> handles;
+			vector<bool> contained;
+
+		public:
+			void reset(size_t n) {
+				for (const auto& [v, _] : heap)
+					contained[v] = false;
+				heap.clear();
+
+				if (handles.size() < n) {
+					handles.resize(n);
+					contained.resize(n, false);
+				}
+			}
+
+			inline bool empty() const noexcept {
+				return heap.empty();
+			}
+
+			inline size_t size() const noexcept {
+				return heap.size();
+			}
+
+			inline void push(vertex_id v, W distance) {
+				if (contained[v])
+					heap.update(handles[v], make_pair(v, distance));
+				else {
+					handles[v] = heap.push(make_pair(v, distance));
+					contained[v] = true;
+				}
+			}
+
+			inline const pair<vertex_id, W>& top() const {
+				return heap.top();
+			}
+
+			inline void pop() {
+				contained[heap.top().first] = false;
+				heap.pop();
+			}
+	};
+
+	template <typename W>
+	using FibonacciHeap = MutableHeap<W, boost::heap::fibonacci_heap>;
+
+	template <typename W>
+	using PairingHeap = MutableHeap<W, boost::heap::pairing_heap>;
+
+	/*
+	* An indexed d-ary heap stored in a single array, with the position of every node so that its distance can be decreased in place.
+	* A wider node makes the heap shallower, which speeds up the decrease of a distance and keeps the children of a node on the same cache lines.
+	*
+	* @param	W	the type of the distances
+	* @param	D	the number of children of a node
+	*/
+	template <typename W, size_t D = 4>
+	class DaryHeap {
+		static_assert(D >= 2, "A d-ary heap needs at least two children per node");
+
+		private:
+			static constexpr size_t npos = numeric_limits<size_t>::max();
+
+			vector<pair<vertex_id, W>> heap;
+			vector<size_t> positions;
+
+		public:
+			void reset(size_t n) {
+				for (const auto& [v, _] : heap)
+					positions[v] = npos;
+				heap.clear();
+
+				if (positions.size() < n)
+					positions.resize(n, npos);
+			}
+
+			inline bool empty() const noexcept {
+				return heap.empty();
+			}
+
+			inline size_t size() const noexcept {
+				return heap.size();
+			}
+
+			void push(vertex_id v, W distance) {
+				if (positions[v] == npos) {
+					heap.emplace_back(v, distance);
+					sift_up(heap.size() - 1);
+				}
+				else if (distance < heap[positions[v]].second) {
+					heap[positions[v]].second = distance;
+					sift_up(positions[v]);
+				}
+			}
+
+			inline const pair<vertex_id, W>& top() const {
+				return heap.front();
+			}
+
+			void pop() {
+				positions[heap.front().first] = npos;
+
+				if (heap.size() > 1) {
+					heap.front() = heap.back();
+					heap.pop_back();
+					sift_down(0);
+				}
+				else
+					heap.pop_back();
+			}
+
+		private:
+			void sift_up(size_t i) {
+				const auto item = heap[i];
+
+				while (i > 0) {
+					const size_t parent = (i - 1) / D;
+					if (heap[parent].second <= item.second)
+						break;
+
+					heap[i] = heap[parent];
+					positions[heap[i].first] = i;
+					i = parent;
+				}
+
+				heap[i] = item;
+				positions[item.first] = i;
+			}
+
+			void sift_down(size_t i) {
+				const auto item = heap[i];
+
+				while (true) {
+					const size_t first = i * D + 1;
+					if (first >= heap.size())
+						break;
+
+					const size_t last = min(first + D, heap.size());
+					size_t child = first;
+					for (size_t c = first + 1; c < last; ++c)
+						if (heap[c].second < heap[child].second)
+							child = c;
+
+					if (item.second <= heap[child].second)
+						break;
+
+					heap[i] = heap[child];
+					positions[heap[i].first] = i;
+					i = child;
+				}
+
+				heap[i] = item;
+				positions[item.first] = i;
+			}
+	};
+
+	template <typename W>
+	using QuaternaryHeap = DaryHeap<W, 4>;
+
+	/*
+	* A binary heap without decrease of a distance: a shorter distance is pushed as a duplicate, and the outdated items are skipped by the search.
+	* The heap is a contiguous array managed by push_heap() and pop_heap(), which has the best constant factors when there are few duplicates.
+	*
+	* @param	W	the type of the distances
+	*/
+	template <typename W>
+	class LazyBinaryHeap {
+		public:
+			/*
+			* The comparator for the items in the heap.
+			*/
+			struct comparator {
+				inline bool operator() (const pair<vertex_id, W>& lhs, const pair<vertex_id, W>& rhs) const {
+					return get<1>(lhs) > get<1>(rhs);
+				}
+			};
+		private:
+			vector<pair<vertex_id, W>> heap;
+
+		public:
+			inline void reset(size_t) noexcept {
+				heap.clear();
+			}
+
+			inline bool empty() const noexcept {
+				return heap.empty();
+			}
+
+			inline size_t size() const noexcept {
+				return heap.size();
+			}
+
+			inline void push(vertex_id v, W distance) {
+				heap.emplace_back(v, distance);
+				push_heap(heap.begin(), heap.end(), comparator());
+			}
+
+			inline const pair<vertex_id, W>& top() const {
+				return heap.front();
+			}
+
+			inline void pop() {
+				pop_heap(heap.begin(), heap.end(), comparator());
+				heap.pop_back();
+			}
+	};
+
+	/*
+	* A radix heap, that only works for integral distances pushed in a monotone order, which is the case in Dijkstra's algorithm.
+	* An item is stored in the bucket given by the highest bit that differs between its distance and the last distance popped,
+	* so that each item moves down at most once per bit. As the lazy binary heap, a shorter distance is pushed as a duplicate.
+	*
+	* @param	W	the type of the distances, which must be integral
+	* @cite	@article{ahuja1990faster, title={Faster algorithms for the shortest path problem}, author={Ahuja, Ravindra K and Mehlhorn, Kurt and Orlin, James and Tarjan, Robert E}, journal={Journal of the ACM}, volume={37}, number={2}, pages={213--223}, year={1990}}
+	*/
+	template <typename W>
+	class RadixHeap {
+		static_assert(is_integral_v<W>, "A radix heap needs integral distances");
+
+		private:
+			using key_type = make_unsigned_t<W>;
+
+			array<vector<pair<vertex_id, W>>, numeric_limits<key_type>::digits + 1> buckets;
+			key_type last = 0;
+			size_t _size = 0;
+
+		public:
+			void reset(size_t) noexcept {
+				for (auto& bucket : buckets)
+					bucket.clear();
+				last = 0;
+				_size = 0;
+			}
+
+			inline bool empty() const noexcept {
+				return _size == 0;
+			}
+
+			inline size_t size() const noexcept {
+				return _size;
+			}
+
+			inline void push(vertex_id v, W distance) {
+				assert(("The distances pushed into a radix heap must not decrease", static_cast<key_type>(distance) >= last));
+
+				buckets[bucket(static_cast<key_type>(distance))].emplace_back(v, distance);
+				++_size;
+			}
+
+			/*
+			* Returns the item with the smallest distance.
+			* The first non-empty bucket is redistributed in the lower buckets when the bucket 0 is empty, hence the method is not const.
+			*/
+			const pair<vertex_id, W>& top() {
+				if (buckets[0].empty()) {
+					size_t i = 1;
+					while (buckets[i].empty())
+						++i;
+
+					last = static_cast<key_type>(min_element(buckets[i].begin(), buckets[i].end(),
+						[](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; })->second);
+
+					for (const auto& item : buckets[i])
+						buckets[bucket(static_cast<key_type>(item.second))].push_back(item);
+					buckets[i].clear();
+				}
+
+				return buckets[0].back();
+			}
+
+			inline void pop() {
+				top();
+				buckets[0].pop_back();
+				--_size;
+			}
+
+		private:
+			/*
+			* Returns the bucket of a distance: 0 if it equals the last distance popped, or the position of the highest bit that differs otherwise.
+			*/
+			inline size_t bucket(key_type distance) const noexcept {
+				key_type bits = distance ^ last;
+
+				#if defined(__GNUC__) || defined(__clang__)
+					return bits == 0 ? 0 : numeric_limits<unsigned long long>::digits - __builtin_clzll(bits);
+				#else
+					size_t i = 0;
+					for (; bits != 0; bits >>= 1)
+						++i;
+					return i;
+				#endif
+			}
+	};
+};
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef HEURISTICS_HPP
+#define HEURISTICS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "dijkstra.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Heuristics for Graph::find_astar(), that estimate the distance from a node to the destination of a search.
+ *	Every heuristic is a functor called as heuristic(v, dst), that returns a lower bound of the distance from v to dst and is consistent along the edges.
+ *	The geometric heuristics scale a length into the unit of the weights, and round it down so that it stays a lower bound:
+ *	they are only admissible if no edge weighs less than the scaled length between its ends.
+ */
+namespace dijkstra {
+	using namespace std;
+
+	/*
+	* The straight-line distance between the planar coordinates of two nodes.
+	*
+	* @param	W	the type of the weights
+	*/
+	template <typename W>
+	class EuclideanHeuristic {
+		private:
+			const Graph<W>& graph;
+			double scale;
+
+		public:
+			/*
+			* Constructor.
+			*
+			* @param	graph	the graph, whose coordinates are read at each call
+			* @param	scale	the weight of an edge per unit of length
+			*/
+			explicit EuclideanHeuristic(const Graph<W>& graph, double scale = 1) noexcept : graph(graph), scale(scale) {}
+
+			inline W operator() (vertex_id v, vertex_id dst) const {
+				const auto& from = graph.get_coordinates(v);
+				const auto& to = graph.get_coordinates(dst);
+
+				return static_cast<W>(min(floor(scale * hypot(to.x - from.x, to.y - from.y)), static_cast<double>(numeric_limits<W>::max() / 2)));
+			}
+	};
+
+	/*
+	* The great-circle distance between two nodes on the surface of the Earth, whose coordinates are their longitude and latitude in degrees.
+	*
+	* @param	W	the type of the weights
+	* @cite	@article{sinnott1984virtues, title={Virtues of the haversine}, author={Sinnott, Roger W}, journal={Sky and Telescope}, volume={68}, number={2}, pages={158}, year={1984}}
+	*/
+	template <typename W>
+	class HaversineHeuristic {
+		private:
+			/*
+			* The coordinates of a node in radians, with the cosine of the latitude.
+			*/
+			struct Position {
+				double longitude;
+				double latitude;
+				double cos_latitude;
+			};
+
+			vector<Position> positions;
+			double scale;
+
+		public:
+			/*
+			* The mean radius of the Earth, in meters.
+			*/
+			static constexpr double radius = 6371008.8;
+
+			/*
+			* Constructor, that converts the coordinates of the nodes once, hence they must be set beforehand.
+			*
+			* @param	graph	the graph
+			* @param	scale	the weight of an edge per meter
+			*/
+			explicit HaversineHeuristic(const Graph<W>& graph, double scale = 1) : scale(scale) {
+				constexpr double degree = 3.14159265358979323846 / 180;
+
+				positions.reserve(graph.get_nodes().size());
+				for (const auto& node : graph.get_nodes())
+					positions.push_back({ node.coordinates.x * degree, node.coordinates.y * degree, cos(node.coordinates.y * degree) });
+			}
+
+			inline W operator() (vertex_id v, vertex_id dst) const {
+				const auto& from = positions[v];
+				const auto& to = positions[dst];
+				const double a = pow(sin((to.latitude - from.latitude) / 2), 2) + from.cos_latitude * to.cos_latitude * pow(sin((to.longitude - from.longitude) / 2), 2);
+
+				return static_cast<W>(min(floor(scale * 2 * radius * asin(min(1.0, sqrt(a)))), static_cast<double>(numeric_limits<W>::max() / 2)));
+			}
+	};
+
+	/*
+	* The ALT heuristic, that bounds distances with the triangle inequality through a few landmarks: for a landmark L,
+	* d(v, dst) >= d(L, dst) - d(L, v) and d(v, dst) >= d(v, L) - d(dst, L).
+	* The landmarks are chosen by farthest selection, each one being the node the farthest from the ones already chosen, so that they lie on the border of the graph.
+	* The distances are computed once, with two searches per landmark in an oriented graph and one otherwise, hence the graph must not change afterwards.
+	*
+	* @param	W	the type of the weights
+	* @cite	@inproceedings{goldberg2005computing, title={Computing the shortest path: A search meets graph theory}, author={Goldberg, Andrew V and Harrelson, Chris}, booktitle={Proceedings of the sixteenth annual ACM-SIAM symposium on Discrete algorithms}, pages={156--165}, year={2005}}
+	*/
+	template <typename W>
+	class LandmarkHeuristic {
+		private:
+			static constexpr W infinity = numeric_limits<W>::max();
+
+			size_t n = 0;
+			vector<vertex_id> _landmarks;
+			vector<W> from;
+			vector<W> to;
+
+		public:
+			/*
+			* Constructor, that chooses the landmarks and computes their distances to and from every node.
+			*
+			* @param	graph	the graph
+			* @param	count	the number of landmarks, fewer if the graph has fewer nodes
+			*/
+			LandmarkHeuristic(const Graph<W>& graph, size_t count) : n(graph.get_nodes().size()) {
+				auto workspace = Workspace<W, QuaternaryHeap>();
+				auto transposed = optional<Graph<W>>();
+				if (graph.get_orientation() == Orientation::ORIENTED)
+					transposed = graph.transpose();
+
+				// the distance from each node to the nearest landmark, seeded by a search from the first node
+				auto nearest = vector<W>(n, infinity);
+				for (vertex_id v = 0; v < n; ++v)
+					if (graph.contains(v)) {
+						graph.shortest_path_tree(v, workspace);
+						nearest = workspace.distances;
+						break;
+					}
+
+				while (_landmarks.size() < count) {
+					auto landmark = static_cast<vertex_id>(n);
+					for (vertex_id v = 0; v < n; ++v)
+						if (nearest[v] != infinity && nearest[v] > 0 && (landmark == n || nearest[v] > nearest[landmark]))
+							landmark = v;
+
+					if (landmark == n)
+						break;
+
+					_landmarks.push_back(landmark);
+					graph.shortest_path_tree(landmark, workspace);
+					from.insert(from.end(), workspace.distances.begin(), workspace.distances.end());
+					if (transposed) {
+						transposed->shortest_path_tree(landmark, workspace);
+						to.insert(to.end(), workspace.distances.begin(), workspace.distances.end());
+					}
+
+					for (vertex_id v = 0; v < n; ++v)
+						nearest[v] = min(nearest[v], from[(_landmarks.size() - 1) * n + v]);
+				}
+			}
+
+			/*
+			* Returns the identifiers of the landmarks.
+			*/
+			inline const vector<vertex_id>& landmarks() const noexcept {
+				return _landmarks;
+			}
+
+			/*
+			* Returns the largest lower bound of the distance from a node to another through the landmarks.
+			* A node that cannot reach a landmark that dst reaches cannot reach dst either, and is bounded by numeric_limits<W>::max() / 2,
+			* so that the heuristic stays consistent along the edges that leave the nodes able to reach dst.
+			*
+			* @param	v	the identifier of the node
+			* @param	dst	the identifier of the destination node
+			* @return	the lower bound
+			*/
+			inline W operator() (vertex_id v, vertex_id dst) const {
+				W result = 0;
+
+				// the other bounds through an unreachable landmark are skipped
+				for (size_t l = 0; l < _landmarks.size(); ++l) {
+					const W* _from = from.data() + l * n;
+					const W* _to = to.empty() ? _from : to.data() + l * n;
+
+					if (_to[v] == infinity && _to[dst] != infinity)
+						return infinity / 2;
+					if (_from[v] != infinity && _from[dst] != infinity && _from[dst] > _from[v])
+						result = max<W>(result, _from[dst] - _from[v]);
+					if (_to[v] != infinity && _to[dst] != infinity && _to[v] > _to[dst])
+						result = max<W>(result, _to[v] - _to[dst]);
+				}
+
+				return result;
+			}
+	};
+};
+
+#endif
@@ -0,0 +1,360 @@
+#ifndef LOADER_HPP
+#define LOADER_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "dijkstra.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Bulk loaders building a FrozenGraph from DIMACS, edge list and METIS files.
+ *	The files are streamed through a fixed-size buffer, and the edges are grouped by source node in one pass once they are all read.
+ */
+namespace dijkstra {
+	using namespace std;
+	namespace fs = std::filesystem;
+
+	/*
+	* Reads a file line by line through a fixed-size buffer, without allocating a string per line.
+	* The buffer only grows if a single line does not fit in it.
+	*/
+	class LineReader {
+		private:
+			ifstream file;
+			vector<char> buffer;
+			size_t begin = 0;
+			size_t end = 0;
+			size_t _line = 0;
+
+		public:
+			/*
+			* Constructor.
+			*
+			* @param	path	the path of the file
+			* @param	capacity	the size of the buffer
+			*/
+			LineReader(const fs::path& path, size_t capacity = size_t(1) << 20) : file(path, ios::binary), buffer(capacity) {
+				if (!file)
+					throw runtime_error("Cannot open " + path.string());
+			}
+
+			/*
+			* Returns the number of the last line read, starting at 1.
+			*/
+			inline size_t line() const noexcept {
+				return _line;
+			}
+
+			/*
+			* Reads the next line, without its end of line characters.
+			*
+			* @param	line	the line, valid until the next call
+			* @return	true if a line has been read, or false at the end of the file
+			*/
+			bool next(string_view& line) {
+				while (true) {
+					if (auto newline = static_cast<const char*>(memchr(buffer.data() + begin, '\n', end - begin))) {
+						line = trim(string_view(buffer.data() + begin, newline - (buffer.data() + begin)));
+						begin = newline - buffer.data() + 1;
+						++_line;
+						return true;
+					}
+
+					// the last line may not end with a newline
+					if (!file) {
+						if (begin == end)
+							return false;
+
+						line = trim(string_view(buffer.data() + begin, end - begin));
+						begin = end;
+						++_line;
+						return true;
+					}
+
+					refill();
+				}
+			}
+
+		private:
+			/*
+			* Moves the incomplete line at the front of the buffer and reads the file after it.
+			*/
+			void refill() {
+				copy(buffer.begin() + begin, buffer.begin() + end, buffer.begin());
+				end -= begin;
+				begin = 0;
+
+				if (end == buffer.size())
+					buffer.resize(buffer.size() * 2);
+
+				file.read(buffer.data() + end, buffer.size() - end);
+				end += static_cast<size_t>(file.gcount());
+			}
+
+			static inline string_view trim(string_view line) noexcept {
+				if (!line.empty() && line.back() == '\r')
+					line.remove_suffix(1);
+
+				return line;
+			}
+	};
+
+	/*
+	* Parses a whole field as a number.
+	*
+	* @param	field	the field
+	* @param	value	the number
+	* @return	true if the field is a number, or false otherwise
+	*/
+	template <typename T>
+	inline bool parse(string_view field, T& value) noexcept {
+		const auto [end, error] = from_chars(field.data(), field.data() + field.size(), value);
+
+		return error == errc() && end == field.data() + field.size();
+	}
+
+	/*
+	* Splits a line into fields.
+	*/
+	class Fields {
+		private:
+			string_view rest;
+			char delimiter;
+
+		public:
+			/*
+			* Constructor.
+			*
+			* @param	line	the line
+			* @param	delimiter	the delimiter of the fields, or 0 to split on any run of blanks
+			*/
+			Fields(string_view line, char delimiter = 0) noexcept : rest(line), delimiter(delimiter) {}
+
+			/*
+			* Reads the next field.
+			*
+			* @param	field	the field
+			* @return	true if there was a field left, or false otherwise
+			*/
+			bool next(string_view& field) noexcept {
+				if (delimiter == 0) {
+					const auto first = rest.find_first_not_of(" \t");
+					if (first == string_view::npos)
+						return false;
+
+					rest.remove_prefix(first);
+					const auto last = min(rest.find_first_of(" \t"), rest.size());
+					field = rest.substr(0, last);
+					rest.remove_prefix(last);
+					return true;
+				}
+
+				if (rest.data() == nullptr)
+					return false;
+
+				const auto last = rest.find(delimiter);
+				field = rest.substr(0, last);
+				rest = last == string_view::npos ? string_view() : rest.substr(last + 1);
+				return true;
+			}
+
+			/*
+			* Reads the next field as a number.
+			*
+			* @param	value	the number
+			* @return	true if there was a field left and it is a number, or false otherwise
+			*/
+			template <typename T>
+			bool next(T& value) noexcept {
+				string_view field;
+
+				return next(field) && parse(field, value);
+			}
+	};
+
+	/*
+	* Throws an error about a malformed line.
+	*/
+	[[noreturn]] inline void malformed(const fs::path& path, const LineReader& reader) {
+		throw runtime_error("Malformed line " + to_string(reader.line()) + " in " + path.string());
+	}
+
+	/*
+	* Loads a graph in the DIMACS shortest path format: a problem line "p sp <nodes> <edges>", followed by one line "a <source> <destination> <weight>" per edge.
+	* The nodes are numbered from 1 in the file, and labelled by their number in the graph.
+	*
+	* @param	path	the path of the .gr file
+	* @param	_or	the edge orientation
+	* @return	the frozen graph, where the node labelled "i" has the identifier i - 1
+	* @cite	http://www.diag.uniroma1.it/challenge9/format.shtml
+	*/
+	template <typename W = uint_fast32_t>
+	FrozenGraph<W> load_dimacs(const fs::path& path, Orientation _or = Orientation::ORIENTED) {
+		auto reader = LineReader(path);
+		auto edges = vector<tuple<vertex_id, vertex_id, W>>();
+		size_t n = 0;
+		string_view line, tag;
+
+		while (reader.next(line)) {
+			auto fields = Fields(line);
+			if (!fields.next(tag))
+				continue;
+
+			if (tag == "p") {
+				size_t m = 0;
+				if (!fields.next(tag) || !fields.next(n) || !fields.next(m))
+					malformed(path, reader);
+				edges.reserve(m);
+			}
+			else if (tag == "a") {
+				vertex_id source = 0, target = 0;
+				W weight = 0;
+				if (!fields.next(source) || !fields.next(target) || !fields.next(weight) || source == 0 || target == 0 || source > n || target > n)
+					malformed(path, reader);
+				edges.emplace_back(source - 1, target - 1, weight);
+			}
+			else if (tag != "c")
+				malformed(path, reader);
+		}
+
+		auto labels = vector<string>();
+		labels.reserve(n);
+		for (size_t v = 1; v <= n; ++v)
+			labels.push_back(to_string(v));
+
+		return FrozenGraph<W>(_or, labels, edges);
+	}
+
+	/*
+	* Loads a graph from an edge list, with one line "<source><delimiter><destination>[<delimiter><weight>]" per edge, such as a CSV or TSV file.
+	* The weight defaults to 0, as with Graph::add_edge(). The empty lines and the lines starting with # are skipped.
+	* The labels are looked up as they are read from the buffer, and only copied the first time they appear.
+	* The edges are reserved from the size of the file and the length of the first edge line.
+	*
+	* @param	path	the path of the file
+	* @param	delimiter	the delimiter of the fields
+	* @param	_or	the edge orientation
+	* @param	nodes	the expected number of nodes, to reserve the labels, or 0 if unknown
+	* @return	the frozen graph, where the nodes are numbered in the order they first appear
+	*/
+	template <typename W = uint_fast32_t>
+	FrozenGraph<W> load_edge_list(const fs::path& path, char delimiter = ',', Orientation _or = Orientation::UNORIENTED, size_t nodes = 0) {
+		auto reader = LineReader(path);
+		// a deque, so that the labels never move and the keys of ids can view them
+		auto labels = deque<string>();
+		auto ids = unordered_map<string_view, vertex_id>(nodes);
+		auto edges = vector<tuple<vertex_id, vertex_id, W>>();
+		string_view line, source, target, field;
+
+		auto id = [&](string_view label) {
+			if (auto it = ids.find(label); it != ids.end())
+				return it->second;
+
+			const auto v = static_cast<vertex_id>(labels.size());
+			labels.emplace_back(label);
+			ids.emplace(labels.back(), v);
+
+			return v;
+		};
+
+		while (reader.next(line)) {
+			if (line.empty() || line.front() == '#')
+				continue;
+
+			if (edges.empty())
+				edges.reserve(fs::file_size(path) / (line.size() + 1));
+
+			auto fields = Fields(line, delimiter);
+			W weight = 0;
+			if (!fields.next(source) || !fields.next(target))
+				malformed(path, reader);
+			if (fields.next(field) && !parse(field, weight))
+				malformed(path, reader);
+
+			edges.emplace_back(id(source), id(target), weight);
+		}
+
+		ids.clear();
+
+		return FrozenGraph<W>(_or, vector<string>(make_move_iterator(labels.begin()), make_move_iterator(labels.end())), edges);
+	}
+
+	/*
+	* Loads an unoriented graph in the METIS format: a header "<nodes> <edges> [<fmt> [<ncon>]]", followed by the neighbors of each node on its own line.
+	* The nodes are numbered from 1 in the file, and labelled by their number in the graph. The node weights are skipped, and the edge weights default to 1.
+	*
+	* @param	path	the path of the .graph file
+	* @return	the frozen graph, where the node labelled "i" has the identifier i - 1
+	* @cite	http://glaros.dtc.umn.edu/gkhome/fetch/sw/metis/manual.pdf
+	*/
+	template <typename W = uint_fast32_t>
+	FrozenGraph<W> load_metis(const fs::path& path) {
+		auto reader = LineReader(path);
+		auto edges = vector<tuple<vertex_id, vertex_id, W>>();
+		size_t n = 0, m = 0, ncon = 1;
+		string fmt = "000";
+		string_view line, field;
+
+		// the header is the first line that is not a comment
+		do {
+			if (!reader.next(line))
+				malformed(path, reader);
+		} while (!line.empty() && line.front() == '%');
+
+		auto header = Fields(line);
+		if (!header.next(n) || !header.next(m))
+			malformed(path, reader);
+		if (header.next(field))
+			fmt = string(3 - min<size_t>(field.size(), 3), '0') + string(field.substr(0, 3));
+		if (!header.next(ncon))
+			ncon = 1;
+
+		const bool node_sizes = fmt[0] == '1', node_weights = fmt[1] == '1', edge_weights = fmt[2] == '1';
+
+		// each edge is listed in the lines of both its ends, and only kept from its lower end
+		edges.reserve(m);
+		for (vertex_id source = 0; source < n;) {
+			if (!reader.next(line))
+				malformed(path, reader);
+			if (!line.empty() && line.front() == '%')
+				continue;
+
+			auto fields = Fields(line);
+			for (size_t skip = (node_sizes ? 1 : 0) + (node_weights ? ncon : 0); skip > 0; --skip)
+				if (!fields.next(field))
+					malformed(path, reader);
+
+			for (vertex_id target = 0; fields.next(field);) {
+				W weight = 1;
+				if (!parse(field, target) || target == 0 || target > n || (edge_weights && !fields.next(weight)))
+					malformed(path, reader);
+
+				if (source <= target - 1)
+					edges.emplace_back(source, target - 1, weight);
+			}
+
+			++source;
+		}
+
+		auto labels = vector<string>();
+		labels.reserve(n);
+		for (size_t v = 1; v <= n; ++v)
+			labels.push_back(to_string(v));
+
+		return FrozenGraph<W>(Orientation::UNORIENTED, labels, edges);
+	}
+};
+
+#endif
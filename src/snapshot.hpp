@@ -0,0 +1,352 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(_WIN32)
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "dijkstra.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Binary snapshots of a FrozenGraph, that are mapped in memory to serve queries without parsing nor copying the file.
+ *	A snapshot is made of a header followed by the arrays of the graph, each one padded to 8 bytes:
+ *	- header : the magic "DIJKSNAP", the version (uint32), the orientation, the size and signedness of the weights (uint8 each), 9 bytes of padding,
+ *		and the number of nodes, of edges, and of bytes in the labels (uint64 each)
+ *	- offsets (uint64), targets (uint32), weights (W)
+ *	- rev_offsets (uint64), rev_sources (uint32), rev_weights (W), only in oriented graphs
+ *	- label_offsets (uint64), sorted (uint32), label_chars (char)
+ *	All the integers are stored in little-endian order, whatever the host, so that a snapshot can be moved between hosts.
+ *	The file is mapped shared and read-only: the processes serving the same snapshot on a host share its pages in the page cache.
+ */
+namespace dijkstra {
+	using namespace std;
+	namespace fs = std::filesystem;
+
+	/*
+	* The version of the snapshot format, to increment on any change of the layout.
+	*/
+	constexpr uint32_t snapshot_version = 1;
+
+	/*
+	* The magic number at the beginning of a snapshot.
+	*/
+	constexpr array<char, 8> snapshot_magic = { 'D', 'I', 'J', 'K', 'S', 'N', 'A', 'P' };
+
+	/*
+	* Checks if the host stores integers in little-endian order, in which case the arrays of a snapshot can be used in place.
+	*/
+	inline bool is_little_endian() noexcept {
+		const uint16_t probe = 1;
+		unsigned char first = 0;
+		memcpy(&first, &probe, 1);
+
+		return first == 1;
+	}
+
+	/*
+	* A read-only shared mapping of a whole file, unmapped on destruction.
+	*/
+	class MappedFile {
+		private:
+			const char* _data = nullptr;
+			size_t _size = 0;
+			#if defined(_WIN32)
+				HANDLE file = INVALID_HANDLE_VALUE;
+				HANDLE mapping = nullptr;
+			#endif
+
+		public:
+			/*
+			* Constructor.
+			*
+			* @param	path	the path of the file
+			*/
+			explicit MappedFile(const fs::path& path) {
+				#if defined(_WIN32)
+					file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+					if (file == INVALID_HANDLE_VALUE)
+						throw runtime_error("Cannot open " + path.string());
+
+					LARGE_INTEGER size;
+					GetFileSizeEx(file, &size);
+					_size = static_cast<size_t>(size.QuadPart);
+
+					if (_size > 0) {
+						mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+						if (mapping != nullptr)
+							_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+						if (_data == nullptr) {
+							if (mapping != nullptr)
+								CloseHandle(mapping);
+							CloseHandle(file);
+							throw runtime_error("Cannot map " + path.string());
+						}
+					}
+				#else
+					const int fd = ::open(path.c_str(), O_RDONLY);
+					if (fd < 0)
+						throw runtime_error("Cannot open " + path.string());
+
+					struct stat status;
+					if (fstat(fd, &status) != 0) {
+						::close(fd);
+						throw runtime_error("Cannot open " + path.string());
+					}
+					_size = static_cast<size_t>(status.st_size);
+
+					if (_size > 0) {
+						void* address = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+						if (address == MAP_FAILED) {
+							::close(fd);
+							throw runtime_error("Cannot map " + path.string());
+						}
+						_data = static_cast<const char*>(address);
+					}
+
+					// the mapping stays valid once the descriptor is closed
+					::close(fd);
+				#endif
+			}
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			/*
+			* Destructor.
+			*/
+			~MappedFile() noexcept {
+				#if defined(_WIN32)
+					if (_data != nullptr)
+						UnmapViewOfFile(_data);
+					if (mapping != nullptr)
+						CloseHandle(mapping);
+					if (file != INVALID_HANDLE_VALUE)
+						CloseHandle(file);
+				#else
+					if (_data != nullptr)
+						munmap(const_cast<char*>(_data), _size);
+				#endif
+			}
+
+			inline const char* data() const noexcept {
+				return _data;
+			}
+
+			inline size_t size() const noexcept {
+				return _size;
+			}
+	};
+
+	namespace snapshot {
+		/*
+		* Writes a value in little-endian order.
+		*/
+		template <typename T>
+		void write(ofstream& file, T value) {
+			array<char, sizeof(T)> bytes;
+			memcpy(bytes.data(), &value, sizeof(T));
+			if (!is_little_endian())
+				reverse(bytes.begin(), bytes.end());
+
+			file.write(bytes.data(), bytes.size());
+		}
+
+		/*
+		* Reads a value stored in little-endian order.
+		*/
+		template <typename T>
+		T read(const char* data) noexcept {
+			array<char, sizeof(T)> bytes;
+			copy(data, data + sizeof(T), bytes.begin());
+			if (!is_little_endian())
+				reverse(bytes.begin(), bytes.end());
+
+			T value;
+			memcpy(&value, bytes.data(), sizeof(T));
+			return value;
+		}
+
+		/*
+		* Returns the size of an array in the file, padded to 8 bytes.
+		*/
+		template <typename T>
+		constexpr size_t padded(size_t count) noexcept {
+			return (count * sizeof(T) + 7) / 8 * 8;
+		}
+
+		/*
+		* Writes an array, padded to 8 bytes.
+		*/
+		template <typename T>
+		void write(ofstream& file, ArrayView<T> values) {
+			if (is_little_endian() || sizeof(T) == 1)
+				file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+			else
+				for (const auto& value : values)
+					write(file, value);
+
+			static const array<char, 8> padding = {};
+			file.write(padding.data(), padded<T>(values.size()) - values.size() * sizeof(T));
+		}
+
+		/*
+		* Views an array in the mapped file, and moves the cursor after its padding.
+		*/
+		template <typename T>
+		ArrayView<T> view(const char*& cursor, size_t count) noexcept {
+			const auto result = ArrayView<T>(reinterpret_cast<const T*>(cursor), count);
+			cursor += padded<T>(count);
+
+			return result;
+		}
+
+		/*
+		* Checks that the offsets of an array start at 0, never decrease and end at its size.
+		*/
+		inline bool is_consistent(ArrayView<uint64_t> offsets, uint64_t size) noexcept {
+			return offsets.size() > 0 && offsets.data()[0] == 0 && offsets.data()[offsets.size() - 1] == size && is_sorted(offsets.begin(), offsets.end());
+		}
+
+		/*
+		* Checks that every identifier of an array is below a number of nodes.
+		*/
+		inline bool is_bounded(ArrayView<vertex_id> ids, uint64_t n) noexcept {
+			return all_of(ids.begin(), ids.end(), [n](vertex_id v) { return v < n; });
+		}
+
+		constexpr size_t header_size = 48;
+	};
+
+	/*
+	* Saves a frozen graph as a snapshot.
+	*
+	* @param	graph	the graph
+	* @param	path	the path of the snapshot
+	*/
+	template <typename W>
+	void save_snapshot(const FrozenGraph<W>& graph, const fs::path& path) {
+		auto file = ofstream(path, ios::binary | ios::trunc);
+		if (!file)
+			throw runtime_error("Cannot open " + path.string());
+
+		const auto layout = graph.get_layout();
+
+		file.write(snapshot_magic.data(), snapshot_magic.size());
+		snapshot::write<uint32_t>(file, snapshot_version);
+		snapshot::write<uint8_t>(file, static_cast<uint8_t>(graph.get_orientation()));
+		snapshot::write<uint8_t>(file, sizeof(W));
+		snapshot::write<uint8_t>(file, is_signed_v<W>);
+		file.write("\0\0\0\0\0\0\0\0\0", 9);
+		snapshot::write<uint64_t>(file, graph.size());
+		snapshot::write<uint64_t>(file, graph.edge_count());
+		snapshot::write<uint64_t>(file, layout.label_chars.size());
+
+		snapshot::write(file, layout.offsets);
+		snapshot::write(file, layout.targets);
+		snapshot::write(file, layout.weights);
+		if (graph.get_orientation() == Orientation::ORIENTED) {
+			snapshot::write(file, layout.rev_offsets);
+			snapshot::write(file, layout.rev_sources);
+			snapshot::write(file, layout.rev_weights);
+		}
+		snapshot::write(file, layout.label_offsets);
+		snapshot::write(file, layout.sorted);
+		snapshot::write(file, layout.label_chars);
+
+		if (!file.flush())
+			throw runtime_error("Cannot write " + path.string());
+	}
+
+	/*
+	* Opens a snapshot by mapping it in memory: the arrays of the graph point into the mapping, and its pages are only read when the queries touch them.
+	* The mapping is released with the last copy of the graph.
+	* The header and the ends of the offsets are always checked. The offsets and identifiers of the whole file are validated as well unless told otherwise,
+	* in one sequential pass, so that a corrupt file cannot make the queries read out of the arrays; a trusted snapshot then opens in time independent of its size.
+	*
+	* @param	path	the path of the snapshot
+	* @param	validate	true to check every offset and identifier, or false to trust the file
+	* @return	the frozen graph
+	*/
+	template <typename W = uint_fast32_t>
+	FrozenGraph<W> open_snapshot(const fs::path& path, bool validate = true) {
+		if (!is_little_endian())
+			throw runtime_error("The snapshots can only be mapped on little-endian hosts");
+
+		auto mapping = make_shared<MappedFile>(path);
+		const char* data = mapping->data();
+
+		if (mapping->size() < snapshot::header_size || !equal(snapshot_magic.begin(), snapshot_magic.end(), data))
+			throw runtime_error(path.string() + " is not a snapshot");
+		if (snapshot::read<uint32_t>(data + 8) != snapshot_version)
+			throw runtime_error(path.string() + " has an unsupported version");
+		if (snapshot::read<uint8_t>(data + 13) != sizeof(W) || snapshot::read<uint8_t>(data + 14) != is_signed_v<W>)
+			throw runtime_error(path.string() + " has another type of weights");
+
+		const auto orientation = snapshot::read<uint8_t>(data + 12);
+		if (orientation != static_cast<uint8_t>(Orientation::ORIENTED) && orientation != static_cast<uint8_t>(Orientation::UNORIENTED))
+			throw runtime_error(path.string() + " has an unknown orientation");
+
+		const auto _or = static_cast<Orientation>(orientation);
+		const auto n = snapshot::read<uint64_t>(data + 24);
+		const auto m = snapshot::read<uint64_t>(data + 32);
+		const auto label_bytes = snapshot::read<uint64_t>(data + 40);
+
+		// bounds the counts by the size of the file, so that the size of the arrays cannot overflow
+		if (n >= numeric_limits<vertex_id>::max() || n > mapping->size() / sizeof(uint64_t) || m > mapping->size() / sizeof(vertex_id) || label_bytes > mapping->size())
+			throw runtime_error(path.string() + " is truncated");
+		const size_t edges_size = snapshot::padded<uint64_t>(n + 1) + snapshot::padded<vertex_id>(m) + snapshot::padded<W>(m);
+
+		if (mapping->size() != snapshot::header_size + edges_size * (_or == Orientation::ORIENTED ? 2 : 1)
+			+ snapshot::padded<uint64_t>(n + 1) + snapshot::padded<vertex_id>(n) + snapshot::padded<char>(label_bytes))
+			throw runtime_error(path.string() + " is truncated");
+
+		auto layout = typename FrozenGraph<W>::Layout();
+		const char* cursor = data + snapshot::header_size;
+
+		layout.offsets = snapshot::view<uint64_t>(cursor, n + 1);
+		layout.targets = snapshot::view<vertex_id>(cursor, m);
+		layout.weights = snapshot::view<W>(cursor, m);
+		if (_or == Orientation::ORIENTED) {
+			layout.rev_offsets = snapshot::view<uint64_t>(cursor, n + 1);
+			layout.rev_sources = snapshot::view<vertex_id>(cursor, m);
+			layout.rev_weights = snapshot::view<W>(cursor, m);
+		}
+		layout.label_offsets = snapshot::view<uint64_t>(cursor, n + 1);
+		layout.sorted = snapshot::view<vertex_id>(cursor, n);
+		layout.label_chars = snapshot::view<char>(cursor, label_bytes);
+
+		auto valid = layout.offsets.data()[n] == m && layout.label_offsets.data()[n] == label_bytes && (_or != Orientation::ORIENTED || layout.rev_offsets.data()[n] == m);
+
+		if (valid && validate) {
+			valid = snapshot::is_consistent(layout.offsets, m) && snapshot::is_bounded(layout.targets, n)
+				&& snapshot::is_consistent(layout.label_offsets, label_bytes) && snapshot::is_bounded(layout.sorted, n);
+			if (_or == Orientation::ORIENTED)
+				valid = valid && snapshot::is_consistent(layout.rev_offsets, m) && snapshot::is_bounded(layout.rev_sources, n);
+		}
+		if (!valid)
+			throw runtime_error(path.string() + " is corrupt");
+
+		return FrozenGraph<W>(_or, layout, move(mapping));
+	}
+};
+
+#endif
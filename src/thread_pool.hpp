@@ -0,0 +1,226 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * @author Antoine Sébert
+ * @description A small work-stealing thread pool to run independent searches of dijkstra.hpp in parallel.
+ */
+namespace dijkstra {
+	using namespace std;
+
+	/*
+	* A fixed set of threads running parallel loops.
+	* The iterations of a loop are split in one contiguous range per thread. A thread takes its iterations from the front of its own range,
+	* and once it is empty, steals the back half of the largest remaining range, so that uneven searches do not leave threads idle.
+	* The calling thread takes part in the loop as the worker 0.
+	*/
+	class ThreadPool {
+		private:
+			/*
+			* The iterations left to a worker, on its own cache line to avoid false sharing.
+			*/
+			struct alignas(64) Range {
+				mutex lock;
+				size_t begin = 0;
+				size_t end = 0;
+			};
+
+			vector<thread> threads;
+			unique_ptr<Range[]> ranges;
+			function<void(size_t, size_t)> body;
+			exception_ptr error;
+			mutex lock;
+			condition_variable wake;
+			condition_variable done;
+			size_t generation = 0;
+			size_t running = 0;
+			bool stopping = false;
+
+		public:
+			/*
+			* Constructor.
+			*
+			* @param	size	the number of workers, including the calling thread
+			*/
+			explicit ThreadPool(size_t size = thread::hardware_concurrency()) : ranges(make_unique<Range[]>(max<size_t>(size, 1))) {
+				for (size_t worker = 1; worker < max<size_t>(size, 1); ++worker)
+					threads.emplace_back([this, worker] { work(worker); });
+			}
+
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+
+			/*
+			* Destructor, that joins the threads.
+			*/
+			~ThreadPool() noexcept {
+				{
+					lock_guard<mutex> guard(lock);
+					stopping = true;
+				}
+				wake.notify_all();
+
+				for (auto& t : threads)
+					t.join();
+			}
+
+			/*
+			* Returns the number of workers, including the calling thread.
+			*/
+			inline size_t size() const noexcept {
+				return threads.size() + 1;
+			}
+
+			/*
+			* Runs body(i, worker) for every i in [0, n), and waits for all of them to complete.
+			* The worker index is lower than size(), and no two calls run at the same time with the same worker index,
+			* so that it can index per-thread state. The first exception thrown by body is rethrown once the loop is over.
+			*
+			* @param	n	the number of iterations
+			* @param	body	the body of the loop
+			*/
+			void parallel_for(size_t n, function<void(size_t, size_t)> body) {
+				for (size_t worker = 0; worker < size(); ++worker) {
+					lock_guard<mutex> guard(ranges[worker].lock);
+					ranges[worker].begin = n * worker / size();
+					ranges[worker].end = n * (worker + 1) / size();
+				}
+
+				{
+					lock_guard<mutex> guard(lock);
+					this->body = move(body);
+					error = nullptr;
+					running = threads.size();
+					++generation;
+				}
+				wake.notify_all();
+
+				run(0);
+
+				unique_lock<mutex> guard(lock);
+				done.wait(guard, [this] { return running == 0; });
+				this->body = nullptr;
+
+				if (error)
+					rethrow_exception(error);
+			}
+
+		private:
+			/*
+			* The loop of the threads, waiting for a new parallel loop or the destruction of the pool.
+			*
+			* @param	worker	the index of the worker
+			*/
+			void work(size_t worker) {
+				size_t seen = 0;
+
+				while (true) {
+					{
+						unique_lock<mutex> guard(lock);
+						wake.wait(guard, [&] { return stopping || generation != seen; });
+						if (stopping)
+							return;
+						seen = generation;
+					}
+
+					run(worker);
+
+					{
+						lock_guard<mutex> guard(lock);
+						--running;
+					}
+					done.notify_one();
+				}
+			}
+
+			/*
+			* Runs the iterations of a worker, then the ones it steals.
+			*
+			* @param	worker	the index of the worker
+			*/
+			void run(size_t worker) {
+				try {
+					for (size_t i = 0;;) {
+						if (take(worker, i))
+							body(i, worker);
+						else if (!steal(worker))
+							break;
+					}
+				}
+				catch (...) {
+					lock_guard<mutex> guard(lock);
+					if (!error)
+						error = current_exception();
+				}
+			}
+
+			/*
+			* Takes the next iteration of a worker.
+			*
+			* @param	worker	the index of the worker
+			* @param	i	the iteration taken
+			* @return	true if there was an iteration left, or false otherwise
+			*/
+			inline bool take(size_t worker, size_t& i) {
+				lock_guard<mutex> guard(ranges[worker].lock);
+
+				if (ranges[worker].begin == ranges[worker].end)
+					return false;
+
+				i = ranges[worker].begin++;
+				return true;
+			}
+
+			/*
+			* Moves the back half of the largest range of the other workers to the range of a worker.
+			*
+			* @param	worker	the index of the thief
+			* @return	true if some iterations have been stolen, or false if the loop is over
+			*/
+			bool steal(size_t worker) {
+				while (true) {
+					size_t victim = worker, largest = 0;
+
+					for (size_t other = 0; other < size(); ++other)
+						if (other != worker) {
+							lock_guard<mutex> guard(ranges[other].lock);
+							if (ranges[other].end - ranges[other].begin > largest) {
+								largest = ranges[other].end - ranges[other].begin;
+								victim = other;
+							}
+						}
+
+					if (victim == worker)
+						return false;
+
+					size_t begin, end;
+					{
+						lock_guard<mutex> guard(ranges[victim].lock);
+						// the victim may have progressed since its range was measured
+						if (ranges[victim].begin == ranges[victim].end)
+							continue;
+
+						end = ranges[victim].end;
+						begin = ranges[victim].end -= (end - ranges[victim].begin + 1) / 2;
+					}
+
+					lock_guard<mutex> guard(ranges[worker].lock);
+					ranges[worker].begin = begin;
+					ranges[worker].end = end;
+					return true;
+				}
+			}
+	};
+};
+
+#endif
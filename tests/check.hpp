@@ -0,0 +1,21 @@
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+#include <cstdio>
+
+/*
+ * @author Antoine Sébert
+ * @description The checks of the tests, that hold whatever NDEBUG and count the failures instead of stopping at the first one.
+ */
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			++failures; \
+		} \
+	} while (false)
+
+#endif
@@ -0,0 +1,82 @@
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "check.hpp"
+#include "contraction.hpp"
+#include "generators.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Compares the distances and paths of ContractionHierarchy with the shortest path trees of Graph, on random oriented and unoriented graphs.
+ *	Every unpacked path must start and end at the right nodes, follow edges of the original graph and add up their weights.
+ */
+
+using namespace dijkstra;
+using namespace dijkstra::generators;
+
+using weight_type = uint_fast32_t;
+
+/*
+ * Checks every query from a sample of sources against the shortest path tree of each one.
+ */
+static void compare(const Graph<weight_type>& graph, const ContractionHierarchy<weight_type>& hierarchy) {
+	auto query = ContractionHierarchy<weight_type>::Query();
+	const auto n = static_cast<vertex_id>(graph.get_nodes().size());
+
+	for (vertex_id src = 0; src < n; src += 7) {
+		const auto tree = graph.shortest_path_tree<QuaternaryHeap>(src);
+
+		for (vertex_id dst = 0; dst < n; ++dst) {
+			if (dst == src)
+				continue;
+
+			const auto& from = graph.label(src);
+			const auto& to = graph.label(dst);
+			const auto expected = tree.distances[dst];
+
+			CHECK(hierarchy.distance(from, to, query) == expected);
+			if (expected == std::numeric_limits<weight_type>::max())
+				continue;
+
+			const auto path = hierarchy.find(from, to, query);
+			const auto vertices = path.vertices();
+			const auto distances = path.distances();
+
+			CHECK(path.distance() == expected);
+			CHECK(vertices.size() == distances.size() && vertices.size() >= 2);
+			CHECK(hierarchy.label(vertices[0]) == from);
+			CHECK(hierarchy.label(vertices[vertices.size() - 1]) == to);
+
+			// each step is an edge of the original graph, whose weight is the difference of the distances
+			for (size_t i = 0; i + 1 < vertices.size(); ++i) {
+				const auto u = graph.id(hierarchy.label(vertices[i]));
+				const auto v = graph.id(hierarchy.label(vertices[i + 1]));
+				const auto& neighbors = graph.get_nodes()[u].neighbors;
+				const auto edge = neighbors.find(v);
+
+				CHECK(edge != neighbors.end());
+				if (edge != neighbors.end())
+					CHECK(distances[i + 1] - distances[i] == edge->second);
+			}
+		}
+	}
+}
+
+int main() {
+	for (const auto _or : { Orientation::ORIENTED, Orientation::UNORIENTED })
+		for (uint64_t seed = 1; seed <= 3; ++seed) {
+			const auto graph = to_graph(random_graph<weight_type>(300, 900, 100, seed), _or);
+
+			compare(graph, ContractionHierarchy<weight_type>(graph, 2));
+		}
+
+	// the planar-like graphs that the hierarchies are meant for, with many paths of the same length on the grid
+	const auto grid = to_graph(grid_graph<weight_type>(20, 20, 5, 4));
+	compare(grid, ContractionHierarchy<weight_type>(grid, 2));
+
+	const auto road = to_graph(road_graph<weight_type>(400, 100, 4));
+	compare(road, ContractionHierarchy<weight_type>(road, 2));
+
+	return failures;
+}
@@ -0,0 +1,50 @@
+#include <cstdint>
+#include <vector>
+
+#include "check.hpp"
+#include "delta_stepping.hpp"
+#include "generators.hpp"
+
+/*
+ * @author Antoine Sébert
+ * @description Compares the distances of DeltaStepping with the shortest path trees of Graph, on generated graphs with several bucket widths and numbers of threads.
+ *	The widths far below the weights keep most of the nodes in the overflow of the bounded buckets, and make the search jump over the empty ones.
+ */
+
+using namespace dijkstra;
+using namespace dijkstra::generators;
+
+/*
+ * Checks the distances from a few sources with every bucket width and number of threads.
+ */
+template <typename W>
+static void compare(const Graph<W>& graph, const std::vector<W>& deltas) {
+	for (const size_t threads : { 1, 3 }) {
+		auto pool = ThreadPool(threads);
+
+		for (const auto delta : deltas) {
+			const auto engine = DeltaStepping<W>(graph, pool, delta);
+
+			for (vertex_id src = 0; src < graph.get_nodes().size(); src += 97)
+				if (graph.contains(src))
+					CHECK(engine.distances(src, pool) == graph.template shortest_path_tree<QuaternaryHeap>(src).distances);
+		}
+	}
+}
+
+int main() {
+	for (const auto _or : { Orientation::ORIENTED, Orientation::UNORIENTED }) {
+		auto graph = to_graph(random_graph<uint32_t>(500, 2000, 100, 3), _or);
+		// a removed node keeps its identifier, and is unreachable
+		graph.remove_node(vertex_id(7));
+		compare<uint32_t>(graph, { 0, 1, 7, 1000 });
+
+		// one bucket per unit of distance, with weights of up to a billion
+		compare<uint64_t>(to_graph(random_graph<uint64_t>(500, 2000, 1000000000, 5), _or), { 0, 1, 1000, 100000000 });
+	}
+
+	compare<uint32_t>(to_graph(grid_graph<uint32_t>(30, 30, 50, 2)), { 0, 1, 16 });
+	compare<uint32_t>(to_graph(road_graph<uint32_t>(900, 100, 2)), { 0, 1, 64 });
+
+	return failures;
+}